@@ -5,6 +5,10 @@
 
 #include "AABB_Pair.h"
 
+#include "RayPacket.h"
+#include "NearestHeap.h"
+#include "DebugDraw.h"
+
 #include <iostream>
 
 namespace AABBTree
@@ -57,10 +61,13 @@ namespace AABBTree
      */
     void Remove(T* _item)
     {
-      NodeIndex node = Find(_item);
+      if (m_root == NodeType::Null) { return; }
+
       //Find the node that contains the item.
+      NodeIndex node = Find(m_root, _item);
       if (node != NodeType::Null)
       {
+        RemoveNode(node);
         FreeNode(node);
       }
     }
@@ -112,11 +119,99 @@ namespace AABBTree
       CalculatePairs(m_nodes[m_root].children[0], m_nodes[m_root].children[1], _pairs);
     }
 
-    void Draw(Renderer& _renderer)
+    /**
+     * \brief Find the items with a bounding box overlapping an area.
+     * \param [in] _rect     Area to search.
+     * \param [in] _callback Function called with each item found.
+     */
+    template <class Callback>
+    void Query(const Rect& _rect, Callback&& _callback) const
+    {
+      if (m_root == NodeType::Null) { return; }
+      Query(m_root, _rect, _callback);
+    }
+
+    /**
+     * \brief Cast a ray through the tree, visiting the closest nodes first.
+     * \param [in] _ray      Ray to cast.
+     * \param [in] _callback Function called with each item the ray may hit and the
+     *                       distance of the closest hit so far. Returns the distance
+     *                       of the closest hit after testing the item.
+     */
+    template <class Callback>
+    void Raycast(const Ray& _ray, Callback&& _callback) const
     {
       if (m_root == NodeType::Null) { return; }
-      Draw(_renderer, m_root);
-    } //!< Draw the tree nodes.
+
+      float maxDistance = _ray.length;
+      float distance;
+      if (_ray.Intersects(m_nodes[m_root].rect, maxDistance, distance))
+      {
+        Raycast(m_root, _ray, maxDistance, _callback);
+      }
+    }
+
+    /**
+     * \brief Cast a packet of rays through the tree.
+     * Every node is tested against all the rays in the packet at once.
+     * \param [in, out] _packet   Rays to cast. The max distances are updated with the hits.
+     * \param [in]      _callback Function called with each item, the index of the ray
+     *                            and the distance of its closest hit. Returns the distance
+     *                            of the ray's closest hit after testing the item.
+     */
+    template <class Callback>
+    void Raycast(RayPacket& _packet, Callback&& _callback) const
+    {
+      if (m_root == NodeType::Null) { return; }
+
+      float distance[RayPacket::Size];
+      int mask = _packet.Intersects(m_nodes[m_root].rect, distance);
+      if (mask != 0)
+      {
+        Raycast(m_root, _packet, mask, _callback);
+      }
+    }
+
+    /**
+     * \brief Find the closest items to a point.
+     * Nodes are searched closest first, until the rest are too far
+     * away to hold a closer item.
+     * \param [in]      _point    Position to search from.
+     * \param [in, out] _heap     Search storage, reset by the caller. Holds the items found.
+     * \param [in]      _distance Function returning the distance from the point to an item.
+     */
+    template <class Distance>
+    void Nearest(const Vector2& _point, NearestHeap<T>& _heap, Distance&& _distance) const
+    {
+      if (m_root == NodeType::Null) { return; }
+
+      _heap.PushNode(m_root, m_nodes[m_root].rect.Distance(_point));
+
+      typename NearestHeap<T>::Node node;
+      while (_heap.PopNode(node))
+      {
+        const NodeType& current = m_nodes[node.index];
+
+        if (current.IsLeaf())
+        {
+          _heap.Push(current.item, _distance(current.item));
+        }
+        else
+        {
+          for (size_t i = 0; i < current.children.size(); ++i)
+          {
+            NodeIndex child = current.children[i];
+            _heap.PushNode(child, m_nodes[child].rect.Distance(_point));
+          }
+        }
+      }
+    }
+
+    void Draw(DebugDraw& _debug) const
+    {
+      if (m_root == NodeType::Null) { return; }
+      Draw(m_root, 0, _debug);
+    } //!< Add the tree nodes and items to draw.
 
   private:
     /**
@@ -345,6 +440,126 @@ namespace AABBTree
       }
     }
 
+    /**
+     * \brief Find the items in a node overlapping an area.
+     * \param [in] _node     Node to search.
+     * \param [in] _rect     Area to search.
+     * \param [in] _callback Function called with each item found.
+     */
+    template <class Callback>
+    void Query(NodeIndex _node, const Rect& _rect, Callback& _callback) const
+    {
+      //if the area is outside of the node, none of the items can overlap it.
+      if (!Rect::Intersects(m_nodes[_node].rect, _rect)) { return; }
+
+      if (m_nodes[_node].IsLeaf())
+      {
+        //the node is padded, so check the item's actual bounds.
+        if (Rect::Intersects(m_nodes[_node].item->GetAABB(), _rect))
+        {
+          _callback(m_nodes[_node].item);
+        }
+      }
+      else
+      {
+        Query(m_nodes[_node].children[0], _rect, _callback);
+        Query(m_nodes[_node].children[1], _rect, _callback);
+      }
+    }
+
+    /**
+     * \brief Cast a ray through a node the ray has entered.
+     * \param [in]      _node        Node to search.
+     * \param [in]      _ray         Ray to cast.
+     * \param [in, out] _maxDistance Distance of the closest hit.
+     * \param [in]      _callback    Function to test items.
+     */
+    template <class Callback>
+    void Raycast(NodeIndex _node, const Ray& _ray, float& _maxDistance, Callback& _callback) const
+    {
+      if (m_nodes[_node].IsLeaf())
+      {
+        _maxDistance = Min(_maxDistance, _callback(m_nodes[_node].item, _maxDistance));
+        return;
+      }
+
+      NodeIndex first = m_nodes[_node].children[0];
+      NodeIndex second = m_nodes[_node].children[1];
+
+      float firstDistance, secondDistance;
+      bool firstHit = _ray.Intersects(m_nodes[first].rect, _maxDistance, firstDistance);
+      bool secondHit = _ray.Intersects(m_nodes[second].rect, _maxDistance, secondDistance);
+
+      //visit the closest child first, its hits may cull the other child.
+      if (secondHit && (!firstHit || secondDistance < firstDistance))
+      {
+        std::swap(first, second);
+        std::swap(firstDistance, secondDistance);
+        std::swap(firstHit, secondHit);
+      }
+
+      if (firstHit)
+      {
+        Raycast(first, _ray, _maxDistance, _callback);
+      }
+      if (secondHit && secondDistance <= _maxDistance)
+      {
+        Raycast(second, _ray, _maxDistance, _callback);
+      }
+    }
+
+    /**
+     * \brief Cast a packet of rays through a node.
+     * \param [in]      _node     Node to search.
+     * \param [in, out] _packet   Rays to cast.
+     * \param [in]      _mask     Rays that have entered the node.
+     * \param [in]      _callback Function to test items.
+     */
+    template <class Callback>
+    void Raycast(NodeIndex _node, RayPacket& _packet, int _mask, Callback& _callback) const
+    {
+      if (m_nodes[_node].IsLeaf())
+      {
+        for (size_t i = 0; i < RayPacket::Size; ++i)
+        {
+          if (_mask & (1 << i))
+          {
+            float distance = _callback(m_nodes[_node].item, i, _packet.maxDistance[i]);
+            _packet.maxDistance[i] = Min(_packet.maxDistance[i], distance);
+          }
+        }
+        return;
+      }
+
+      NodeIndex first = m_nodes[_node].children[0];
+      NodeIndex second = m_nodes[_node].children[1];
+
+      float firstDistance[RayPacket::Size], secondDistance[RayPacket::Size];
+      int firstMask = _packet.Intersects(m_nodes[first].rect, firstDistance) & _mask;
+      int secondMask = _packet.Intersects(m_nodes[second].rect, secondDistance) & _mask;
+
+      //visit the child the rays reach first.
+      if (secondMask != 0 && (firstMask == 0 ||
+          RayPacket::Nearest(secondDistance, secondMask) < RayPacket::Nearest(firstDistance, firstMask)))
+      {
+        std::swap(first, second);
+        std::swap(firstDistance, secondDistance);
+        std::swap(firstMask, secondMask);
+      }
+
+      if (firstMask != 0)
+      {
+        Raycast(first, _packet, firstMask, _callback);
+      }
+
+      //skip the rays that have hit something before the other child.
+      secondMask = _packet.Cull(secondDistance, secondMask);
+      if (secondMask != 0)
+      {
+        Raycast(second, _packet, secondMask, _callback);
+      }
+    }
+
     void ChildPairs(NodeIndex _node, PairList<T>& _outPairs)
     {
       if (m_nodes[_node].crossed == false)
@@ -440,18 +655,27 @@ namespace AABBTree
       return m_nodes[parent].children[0] == _node ? 0u : 1u;
     }
 
-    void Draw(Renderer& _renderer, NodeIndex _node)
+    void Draw(NodeIndex _node, int _depth, DebugDraw& _debug) const
     {
-      m_nodes[_node].rect.Draw(_renderer);
+      const Rect& rect = m_nodes[_node].rect;
+
+      //nothing inside a node out of view can be seen.
+      if (!_debug.Visible(rect)) { return; }
+
+      bool show = _debug.ShowNode(rect, _depth);
+      if (show) { _debug.AddRect(rect); }
 
       if (m_nodes[_node].IsLeaf())
       {
-        m_nodes[_node].item->GetAABB().Draw(_renderer);
+        const Rect& aabb = m_nodes[_node].item->GetAABB();
+        if (_debug.ShowItem(aabb)) { _debug.AddRect(aabb); }
       }
-      else
+      //the children are deeper and smaller, so they are
+      //only needed for the items once this node is hidden.
+      else if (show || _debug.GetSettings().items)
       {
-        Draw(_renderer, m_nodes[_node].children[0]);
-        Draw(_renderer, m_nodes[_node].children[1]);
+        Draw(m_nodes[_node].children[0], _depth + 1, _debug);
+        Draw(m_nodes[_node].children[1], _depth + 1, _debug);
       }
     }
 
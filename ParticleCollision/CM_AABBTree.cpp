@@ -16,21 +16,98 @@ void CM_AABBTree::Collide()
   AABBTree::PairList<Collider> pairs;
   m_aabbTree.GetColliderPairs(pairs);
 
+  m_narrowPhase.Clear();
   for (auto& pair : pairs)
   {
-    CollisionManager::Collide(*pair.a, *pair.b);
+    m_narrowPhase.Add(pair.a, pair.b);
   }
+  m_narrowPhase.Collide();
 }
 
-void CM_AABBTree::Draw(Renderer& _renderer)
+void CM_AABBTree::DrawDebug(DebugDraw& _debug)
 {
-  m_aabbTree.Draw(_renderer);
+  m_aabbTree.Draw(_debug);
 }
 
 void CM_AABBTree::Insert(const std::shared_ptr<Collider>& _collider)
 { }
 
+void CM_AABBTree::Refit()
+{
+  m_aabbTree.Update();
+}
+
+void CM_AABBTree::QueryRegion(const Rect& _rect, ColliderList& _out)
+{
+  m_aabbTree.Query(_rect, [&_out](Collider* _collider) { _out.push_back(_collider); });
+}
+
+void CM_AABBTree::Nearest(const Vector2& _point, size_t _count, float _maxDistance, NearestHeap<Collider>& _heap)
+{
+  _heap.Reset(_count, _maxDistance);
+
+  m_aabbTree.Nearest(_point, _heap, [&_point](Collider* _collider)
+  {
+    return Max(_collider->Distance(_point), 0.f);
+  });
+
+  _heap.Sort();
+}
+
+bool CM_AABBTree::Raycast(const Ray& _ray, RayHit& _hit)
+{
+  _hit.collider = nullptr;
+  _hit.distance = _ray.length;
+
+  m_aabbTree.Raycast(_ray, [&_ray, &_hit](Collider* _collider, float _maxDistance)
+  {
+    if (_collider->Raycast(_ray, _maxDistance, _hit))
+    {
+      _hit.collider = _collider;
+    }
+    return _hit.distance;
+  });
+
+  return _hit.collider != nullptr;
+}
+
+void CM_AABBTree::Raycasts(const std::vector<Ray>& _rays, std::vector<RayHit>& _hits)
+{
+  _hits.resize(_rays.size());
+
+  RayPacket packet;
+
+  //cast the rays in packets, testing each node against the whole packet.
+  for (size_t i = 0; i < _rays.size(); i += RayPacket::Size)
+  {
+    const Ray* rays = &_rays[i];
+    RayHit* hits = &_hits[i];
+
+    packet.Set(rays, std::min(RayPacket::Size, _rays.size() - i));
+
+    for (size_t j = 0; j < packet.count; ++j)
+    {
+      hits[j].collider = nullptr;
+      hits[j].distance = rays[j].length;
+    }
+
+    m_aabbTree.Raycast(packet, [rays, hits](Collider* _collider, size_t _ray, float _maxDistance)
+    {
+      if (_collider->Raycast(rays[_ray], _maxDistance, hits[_ray]))
+      {
+        hits[_ray].collider = _collider;
+      }
+      return hits[_ray].distance;
+    });
+  }
+}
+
 void CM_AABBTree::Add(const std::shared_ptr<Collider>& _collider)
 {
   m_aabbTree.Insert(_collider.get());
+}
+
+void CM_AABBTree::Remove(Collider* _collider)
+{
+  m_aabbTree.Remove(_collider);
 }
\ No newline at end of file
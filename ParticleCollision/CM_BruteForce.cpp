@@ -13,6 +13,7 @@ void CM_BruteForce::Reset()
 
 void CM_BruteForce::Collide()
 {
+  m_narrowPhase.Clear();
   if (m_colliders.empty()) { return; }
 
   //go through all combonations and test for a collision.
@@ -20,20 +21,69 @@ void CM_BruteForce::Collide()
   {
     for (size_t j = i + 1; j < m_colliders.size(); ++j)
     {
-      CollisionManager::Collide(*m_colliders[i], *m_colliders[j]);
+      m_narrowPhase.Add(m_colliders[i], m_colliders[j]);
     }
   }
+  m_narrowPhase.Collide();
 }
 
-void CM_BruteForce::Draw(Renderer& _renderer)
+void CM_BruteForce::DrawDebug(DebugDraw& _debug)
 {
   for (auto& collider : m_colliders)
   {
-    collider->GetAABB().Draw(_renderer);
+    const Rect& aabb = collider->GetAABB();
+    if (_debug.ShowItem(aabb))
+    {
+      _debug.AddRect(aabb);
+    }
   }
 }
 
 void CM_BruteForce::Insert(const std::shared_ptr<Collider>& _collider)
 {
   m_colliders.emplace_back(_collider.get());
+}
+
+void CM_BruteForce::QueryRegion(const Rect& _rect, ColliderList& _out)
+{
+  for (auto& collider : m_colliders)
+  {
+    if (Rect::Intersects(collider->GetAABB(), _rect))
+    {
+      _out.push_back(collider);
+    }
+  }
+}
+
+void CM_BruteForce::Nearest(const Vector2& _point, size_t _count, float _maxDistance, NearestHeap<Collider>& _heap)
+{
+  _heap.Reset(_count, _maxDistance);
+
+  for (auto& collider : m_colliders)
+  {
+    //skip colliders whose bounds are too far away.
+    if (collider->GetAABB().Distance(_point) <= _heap.Bound())
+    {
+      _heap.Push(collider, Max(collider->Distance(_point), 0.f));
+    }
+  }
+
+  _heap.Sort();
+}
+
+bool CM_BruteForce::Raycast(const Ray& _ray, RayHit& _hit)
+{
+  _hit.collider = nullptr;
+  _hit.distance = _ray.length;
+
+  //test every collider, keeping the closest hit.
+  for (auto& collider : m_colliders)
+  {
+    if (collider->Raycast(_ray, _hit.distance, _hit))
+    {
+      _hit.collider = collider;
+    }
+  }
+
+  return _hit.collider != nullptr;
 }
\ No newline at end of file
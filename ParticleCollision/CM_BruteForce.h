@@ -12,10 +12,18 @@ class CM_BruteForce : public CollisionManager
   void Reset() override;
 
   void Collide() override;
-  void Draw(Renderer& _renderer) override;
+  void DrawDebug(DebugDraw& _debug) override;
 
   void Insert(const std::shared_ptr<Collider>& _collider) override;
 
+  void QueryRegion(const Rect& _rect, ColliderList& _out) override; //!< Find the colliders overlapping an area.
+
+  void Nearest(const Vector2& _point, size_t _count, float _maxDistance, NearestHeap<Collider>& _heap) override; //!< Find the closest colliders to a point.
+
+  bool Raycast(const Ray& _ray, RayHit& _hit) override; //!< Find the closest collider hit by a ray.
+
+  using CollisionManager::Nearest;
+
  private:
    std::vector<Collider*> m_colliders;
 };
@@ -17,18 +17,90 @@ void CM_QuadTree::Collide()
   QuadTree::PairList<Collider> pairs;
   m_quadTree.GetPairs(pairs);
 
+  m_narrowPhase.Clear();
   for (auto& pair : pairs)
   {
-    CollisionManager::Collide(*pair.a, *pair.b);
+    m_narrowPhase.Add(pair.a, pair.b);
   }
+  m_narrowPhase.Collide();
 }
 
-void CM_QuadTree::Draw(Renderer& _renderer)
+void CM_QuadTree::DrawDebug(DebugDraw& _debug)
 {
-  m_quadTree.Draw(_renderer);
+  m_quadTree.Draw(_debug);
 }
 
 void CM_QuadTree::Insert(const std::shared_ptr<Collider>& _collider)
 {
   m_quadTree.Insert(_collider.get());
+}
+
+void CM_QuadTree::Grow(Collider* _collider)
+{
+  m_quadTree.Grow(_collider);
+}
+
+void CM_QuadTree::QueryRegion(const Rect& _rect, ColliderList& _out)
+{
+  m_quadTree.Query(_rect, [&_out](Collider* _collider) { _out.push_back(_collider); });
+}
+
+void CM_QuadTree::Nearest(const Vector2& _point, size_t _count, float _maxDistance, NearestHeap<Collider>& _heap)
+{
+  _heap.Reset(_count, _maxDistance);
+
+  m_quadTree.Nearest(_point, _heap, [&_point](Collider* _collider)
+  {
+    return Max(_collider->Distance(_point), 0.f);
+  });
+
+  _heap.Sort();
+}
+
+bool CM_QuadTree::Raycast(const Ray& _ray, RayHit& _hit)
+{
+  _hit.collider = nullptr;
+  _hit.distance = _ray.length;
+
+  m_quadTree.Raycast(_ray, [&_ray, &_hit](Collider* _collider, float _maxDistance)
+  {
+    if (_collider->Raycast(_ray, _maxDistance, _hit))
+    {
+      _hit.collider = _collider;
+    }
+    return _hit.distance;
+  });
+
+  return _hit.collider != nullptr;
+}
+
+void CM_QuadTree::Raycasts(const std::vector<Ray>& _rays, std::vector<RayHit>& _hits)
+{
+  _hits.resize(_rays.size());
+
+  RayPacket packet;
+
+  //cast the rays in packets, testing each node against the whole packet.
+  for (size_t i = 0; i < _rays.size(); i += RayPacket::Size)
+  {
+    const Ray* rays = &_rays[i];
+    RayHit* hits = &_hits[i];
+
+    packet.Set(rays, std::min(RayPacket::Size, _rays.size() - i));
+
+    for (size_t j = 0; j < packet.count; ++j)
+    {
+      hits[j].collider = nullptr;
+      hits[j].distance = rays[j].length;
+    }
+
+    m_quadTree.Raycast(packet, [rays, hits](Collider* _collider, size_t _ray, float _maxDistance)
+    {
+      if (_collider->Raycast(rays[_ray], _maxDistance, hits[_ray]))
+      {
+        hits[_ray].collider = _collider;
+      }
+      return hits[_ray].distance;
+    });
+  }
 }
\ No newline at end of file
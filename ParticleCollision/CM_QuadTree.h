@@ -14,9 +14,19 @@ class CM_QuadTree : public CollisionManager
   void Reset() override;
 
   void Collide() override;
-  void Draw(Renderer& _renderer) override;
+  void DrawDebug(DebugDraw& _debug) override;
 
   void Insert(const std::shared_ptr<Collider>& _collider) override;
+  void Grow(Collider* _collider) override; //!< Add a collider to the leaves its grown bounds reach.
+
+  void QueryRegion(const Rect& _rect, ColliderList& _out) override; //!< Find the colliders overlapping an area.
+
+  void Nearest(const Vector2& _point, size_t _count, float _maxDistance, NearestHeap<Collider>& _heap) override; //!< Find the closest colliders to a point.
+
+  bool Raycast(const Ray& _ray, RayHit& _hit) override; //!< Find the closest collider hit by a ray.
+  void Raycasts(const std::vector<Ray>& _rays, std::vector<RayHit>& _hits) override; //!< Cast packets of rays.
+
+  using CollisionManager::Nearest;
 
  private:
    QuadTree::QuadTree<Collider, 2, 2> m_quadTree;
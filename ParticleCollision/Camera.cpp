@@ -0,0 +1,50 @@
+#include "Camera.h"
+
+Camera::Camera() :
+  m_zoom(1.f)
+{ }
+
+Camera::~Camera()
+{ }
+
+void Camera::SetViewport(int _width, int _height)
+{
+  m_viewport = Vector2(static_cast<float>(_width), static_cast<float>(_height));
+}
+
+void Camera::SetPosition(const Vector2& _position)
+{
+  m_position = _position;
+}
+
+void Camera::Move(const Vector2& _offset)
+{
+  m_position += _offset;
+}
+
+void Camera::SetZoom(float _zoom)
+{
+  //keep the zoom in a sensible range.
+  m_zoom = Clamp(_zoom, .01f, 100.f);
+}
+
+void Camera::Zoom(float _factor)
+{
+  SetZoom(m_zoom * _factor);
+}
+
+const Vector2& Camera::GetPosition() const
+{
+  return m_position;
+}
+
+float Camera::GetZoom() const
+{
+  return m_zoom;
+}
+
+Rect Camera::GetView() const
+{
+  Vector2 extent = m_viewport * (.5f / m_zoom);
+  return Rect(m_position - extent, m_position + extent);
+}
@@ -0,0 +1,40 @@
+#ifndef _CAMERA_H_
+#define _CAMERA_H_
+
+#include "Rect.h"
+
+/**
+ * \brief Define the area of the world shown on screen.
+ */
+
+class Camera
+{
+ public:
+  Camera(); //!< Constructor.
+  ~Camera(); //!< Destructor.
+
+  /**
+   * \brief Set the size of the area the camera draws to.
+   * \param [in] _width  Width in pixels.
+   * \param [in] _height Height in pixels.
+   */
+  void SetViewport(int _width, int _height);
+
+  void SetPosition(const Vector2& _position); //!< Set the world position at the centre of the view.
+  void Move(const Vector2& _offset); //!< Move the camera in world space.
+
+  void SetZoom(float _zoom); //!< Set the number of pixels per world unit.
+  void Zoom(float _factor); //!< Multiply the zoom.
+
+  const Vector2& GetPosition() const; //!< Get the centre of the view.
+  float GetZoom() const; //!< Get the number of pixels per world unit.
+
+  Rect GetView() const; //!< Get the area of the world that is visible.
+
+ private:
+  Vector2 m_position; //!< Centre of the view in world space.
+  Vector2 m_viewport; //!< Size of the view in pixels.
+  float m_zoom; //!< Pixels per world unit.
+};
+
+#endif //_CAMERA_H_
@@ -16,7 +16,18 @@ Circle::Circle(const Vector2& _position, const Vector2& _velocity, float _radius
 
 void Circle::Draw(Renderer& _renderer)
 {
-  SDL::DrawCircle(_renderer, m_position.x, m_position.y, m_radius);
+  Vector2 position = _renderer.ToScreen(m_position);
+
+  SpriteBatch* sprites = _renderer.GetSprites();
+  if (sprites != nullptr)
+  {
+    sprites->AddCircle(position.x, position.y, Max(_renderer.ToScreen(m_radius), .5f));
+    return;
+  }
+
+  //keep at least a pixel so the circle is still visible when zoomed out.
+  int radius = static_cast<int>(Max(_renderer.ToScreen(m_radius), 1.f));
+  SDL::DrawCircle(_renderer, static_cast<int>(position.x), static_cast<int>(position.y), radius);
 }
 
 bool Circle::CheckCollision(Collider& _other, CollisionData& _data) 
@@ -43,4 +54,19 @@ Range Circle::MinMaxOnAxis(const Vector2& _axis) const
 {
   float pos = Vector2::Dot(m_position, _axis);
   return Range(pos - m_radius, pos + m_radius);
+}
+
+float Circle::Distance(const Vector2& _point) const
+{
+  return (_point - m_position).Magnitude() - m_radius;
+}
+
+bool Circle::Raycast(const Ray& _ray, float _maxDistance, RayHit& _hit) const
+{
+  return CollisionManager::Raycast(_ray, *this, _maxDistance, _hit);
+}
+
+float Circle::GetRadius() const
+{
+  return m_radius;
 }
\ No newline at end of file
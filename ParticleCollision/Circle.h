@@ -49,6 +49,24 @@ class Circle : public Collider
    */
   Range MinMaxOnAxis(const Vector2 &_axis) const override;
 
+  /**
+   * \brief Get the distance from a point to the circle.
+   * \param [in] _point Point in world space.
+   * \return Returns the distance to the edge, negative if the point is inside.
+   */
+  float Distance(const Vector2& _point) const override;
+
+  /**
+   * \brief Check if a ray hits the circle.
+   * \param [in]  _ray         Ray to cast.
+   * \param [in]  _maxDistance Ignore hits further than this.
+   * \param [out] _hit         Information about the hit.
+   * \return Returns true if the ray hits the circle.
+   */
+  bool Raycast(const Ray& _ray, float _maxDistance, RayHit& _hit) const override;
+
+  float GetRadius() const; //!< Get the size of the circle.
+
  private:
   float m_radius; //!< Size of the circle.
 };
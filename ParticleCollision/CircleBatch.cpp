@@ -0,0 +1,106 @@
+#include "CircleBatch.h"
+
+#include "Circle.h"
+#include "Kernels.h"
+
+const size_t CircleBatch::Width;
+
+void CircleBatch::CheckPairs(ColliderPair* _pairs, size_t _count, std::vector<CollisionData>& _contacts)
+{
+  thread_local CircleBatch batch;
+
+  batch.Gather(_pairs, _count);
+  batch.Check();
+  batch.Compact(_pairs, _contacts);
+}
+
+CircleBatch::CircleBatch() :
+  m_count(0u)
+{ }
+
+void CircleBatch::Gather(const ColliderPair* _pairs, size_t _count)
+{
+  m_count = _count;
+
+  //pad to whole groups, the padding is masked out when compacting.
+  size_t size = (_count + Width - 1u) / Width * Width;
+  m_ax.resize(size);
+  m_ay.resize(size);
+  m_bx.resize(size);
+  m_by.resize(size);
+  m_radius.resize(size);
+  m_overlap.resize(size);
+  m_nx.resize(size);
+  m_ny.resize(size);
+  m_hits.resize(size / Width);
+
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const Circle& a = static_cast<const Circle&>(*_pairs[i].a);
+    const Circle& b = static_cast<const Circle&>(*_pairs[i].b);
+
+    m_ax[i] = a.GetPosition().x;
+    m_ay[i] = a.GetPosition().y;
+    m_bx[i] = b.GetPosition().x;
+    m_by[i] = b.GetPosition().y;
+    m_radius[i] = a.GetRadius() + b.GetRadius();
+  }
+
+  for (size_t i = _count; i < size; ++i)
+  {
+    m_ax[i] = m_ay[i] = m_bx[i] = m_by[i] = m_radius[i] = .0f;
+  }
+}
+
+void CircleBatch::Check()
+{
+  CircleLanes lanes;
+  lanes.ax = m_ax.data();
+  lanes.ay = m_ay.data();
+  lanes.bx = m_bx.data();
+  lanes.by = m_by.data();
+  lanes.radius = m_radius.data();
+  lanes.overlap = m_overlap.data();
+  lanes.nx = m_nx.data();
+  lanes.ny = m_ny.data();
+  lanes.hits = m_hits.data();
+  lanes.size = m_hits.size() * Width;
+
+  //uses the widest instruction set the processor has.
+  Kernels::Get().circles(lanes);
+}
+
+void CircleBatch::Compact(const ColliderPair* _pairs, std::vector<CollisionData>& _contacts) const
+{
+  CollisionData data;
+
+  for (size_t group = 0; group < m_hits.size(); ++group)
+  {
+    unsigned int mask = m_hits[group];
+
+    //ignore the padding of the last group.
+    size_t first = group * Width;
+    if (m_count - first < Width)
+    {
+      mask &= (1u << (m_count - first)) - 1u;
+    }
+
+    //visit each set bit.
+    while (mask != 0u)
+    {
+      size_t lane = 0u;
+      while ((mask & (1u << lane)) == 0u) { ++lane; }
+      mask &= mask - 1u;
+
+      size_t i = first + lane;
+      data.a = _pairs[i].a;
+      data.b = _pairs[i].b;
+      data.normal = Vector2(m_nx[i], m_ny[i]);
+
+      //touching at the edge of a.
+      const Circle& circle = static_cast<const Circle&>(*data.a);
+      data.SetPoint(circle.GetPosition() - data.normal * circle.GetRadius(), m_overlap[i]);
+      _contacts.push_back(data);
+    }
+  }
+}
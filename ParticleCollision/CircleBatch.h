@@ -0,0 +1,64 @@
+#ifndef _CIRCLEBATCH_H_
+#define _CIRCLEBATCH_H_
+
+#include <vector>
+
+#include "CollisionData.h"
+#include "NarrowPhase.h"
+
+/**
+ * \brief Check many circle pairs together.
+ * The positions and radii of the pairs are gathered into separate
+ * arrays, padded to a multiple of Width, then checked a group at a
+ * time. Each group gives the overlap and normal of every pair and a
+ * mask of the pairs that hit, only the hits are turned into contacts.
+ */
+
+class CircleBatch
+{
+ public:
+  static const size_t Width = 8; //!< Number of pairs in a group.
+
+  /**
+   * \brief Kernel for the narrow phase.
+   * Uses a batch per thread so the storage is reused.
+   * \param [in]      _pairs    First pair, both colliders must be circles.
+   * \param [in]      _count    Number of pairs.
+   * \param [in, out] _contacts List to append the collisions to.
+   */
+  static void CheckPairs(ColliderPair* _pairs, size_t _count, std::vector<CollisionData>& _contacts);
+
+  CircleBatch(); //!< Constructor.
+
+  /**
+   * \brief Copy the positions and radii of the pairs.
+   * \param [in] _pairs First pair, both colliders must be circles.
+   * \param [in] _count Number of pairs.
+   */
+  void Gather(const ColliderPair* _pairs, size_t _count);
+
+  void Check(); //!< Work out the overlap, normal and hit mask of every gathered pair.
+
+  /**
+   * \brief Add a contact for each pair that hit.
+   * \param [in]      _pairs    Pairs that were gathered.
+   * \param [in, out] _contacts List to append the collisions to.
+   */
+  void Compact(const ColliderPair* _pairs, std::vector<CollisionData>& _contacts) const;
+
+ private:
+  size_t m_count; //!< Number of pairs gathered.
+
+  std::vector<float> m_ax; //!< X of the first circles.
+  std::vector<float> m_ay; //!< Y of the first circles.
+  std::vector<float> m_bx; //!< X of the second circles.
+  std::vector<float> m_by; //!< Y of the second circles.
+  std::vector<float> m_radius; //!< Radii of both circles added together.
+
+  std::vector<float> m_overlap; //!< Depth of each pair.
+  std::vector<float> m_nx; //!< Normal x of each pair, from b to a.
+  std::vector<float> m_ny; //!< Normal y of each pair, from b to a.
+  std::vector<unsigned int> m_hits; //!< Bit mask of the pairs that hit, one per group.
+};
+
+#endif //_CIRCLEBATCH_H_
@@ -2,12 +2,21 @@
 #include "Plane.h"
 #include "CollisionManager.h"
 
+unsigned int Collider::s_nextId = 0u;
+
 Collider::Collider(ColliderType _type, const Vector2 &_position, const Vector2 &_velocity) : 
   m_position(_position), m_velocity(_velocity)
 {
   m_type = _type;
+  m_id = s_nextId++;
 
   m_bounciness = 1.f;
+
+  m_awake = true;
+  m_sleepTime = .0f;
+  m_island = 0u;
+  m_colors = 0u;
+  m_body = 0u;
 }
 
 Collider::~Collider()
@@ -27,6 +36,16 @@ void Collider::Update(float _deltaTime)
 void Collider::Draw(Renderer& _renderer)
 { }
 
+ColliderType Collider::GetType() const
+{
+  return m_type;
+}
+
+unsigned int Collider::GetId() const
+{
+  return m_id;
+}
+
 const Vector2& Collider::GetPosition() const
 {
   return m_position;
@@ -42,6 +61,27 @@ const Rect& Collider::GetAABB() const
   return m_aabb;
 }
 
+bool Collider::IsAwake() const
+{
+  return m_awake;
+}
+
+void Collider::SetAwake(bool _awake)
+{
+  m_awake = _awake && m_invMass != .0f;
+  m_sleepTime = .0f;
+
+  if (!m_awake)
+  {
+    m_velocity = Vector2();
+  }
+}
+
+float Collider::GetSleepTime() const
+{
+  return m_sleepTime;
+}
+
 void Collider::DrawRect(Renderer& _renderer) const
 {
   m_aabb.Draw(_renderer);
@@ -7,6 +7,7 @@
 #include "Renderer.h"
 
 #include "CollisionData.h"
+#include "Ray.h"
 
 #include "QuadTree_IItem.h"
 #include "AABBTree_IItem.h"
@@ -30,6 +31,10 @@ enum class ColliderType
 class Collider : public QuadTree::IItem, public AABBTree::IItem
 {
   friend class CollisionManager;
+  friend class ColliderStore;
+  friend class ContactSolver;
+  friend class Islands;
+  friend class ContinuousCollision;
 
  public:
   Collider(ColliderType _type, const Vector2& _position, const Vector2& _velocity); //!< Constructor.
@@ -50,12 +55,44 @@ class Collider : public QuadTree::IItem, public AABBTree::IItem
    */
   virtual Range MinMaxOnAxis(const Vector2& _axis) const = 0;
 
+  /**
+   * \brief Get the distance from a point to the collider's shape.
+   * \param [in] _point Point in world space.
+   * \return Returns the distance to the surface, negative if the point is inside.
+   */
+  virtual float Distance(const Vector2& _point) const = 0;
+
+  /**
+   * \brief Check if a ray hits the collider.
+   * \param [in]  _ray         Ray to cast.
+   * \param [in]  _maxDistance Ignore hits further than this.
+   * \param [out] _hit         Information about the hit. Only set if there is a hit.
+   * \return Returns true if the ray hits the collider.
+   */
+  virtual bool Raycast(const Ray& _ray, float _maxDistance, RayHit& _hit) const = 0;
+
+  ColliderType GetType() const; //!< Get the type of shape.
+
+  unsigned int GetId() const; //!< Get the number of colliders created before this one, the same every run.
+
   const Vector2& GetVelocity() const; //!< Get the velocity. 
   
   const Vector2& GetPosition() const override; //!< Get the position.
 
   const Rect& GetAABB() const override; //!< Get the bounding box.
 
+  bool IsAwake() const; //!< Is the collider being simulated?
+
+  /**
+   * \brief Wake the collider or put it to sleep.
+   * A sleeping collider is not moved and its velocity is cleared.
+   * Static colliders never wake.
+   * \param [in] _awake Should the collider be simulated?
+   */
+  void SetAwake(bool _awake);
+
+  float GetSleepTime() const; //!< Get how long the collider has been resting.
+
   void DrawRect(Renderer& _renderer) const override;
 
  protected:
@@ -67,8 +104,17 @@ class Collider : public QuadTree::IItem, public AABBTree::IItem
 
   Rect m_aabb; //!< Bounds of the collider.
 
+  bool m_awake; //!< Is the collider being simulated?
+  float m_sleepTime; //!< Time the collider has been resting.
+  size_t m_island; //!< Index used while building islands.
+  unsigned long long m_colors; //!< Colors of the contacts on the collider, used while the solver colors them.
+  unsigned int m_body; //!< Index of the collider in the solver's velocity arrays while solving.
+
  private:
+  static unsigned int s_nextId; //!< Id of the next collider created.
+
   ColliderType m_type; //!< Type of collider.
+  unsigned int m_id; //!< Creation order of the collider.
 };
 
 #endif //_COLLIDER_H_
\ No newline at end of file
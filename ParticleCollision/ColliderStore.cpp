@@ -0,0 +1,295 @@
+#include "ColliderStore.h"
+
+#include <utility>
+#include <cmath>
+
+#include "Kernels.h"
+
+const int ColliderStore::PoolCount;
+const float ColliderStore::FattenMargin = 1.f;
+
+ColliderStore::ColliderStore()
+{ }
+
+ColliderStore::~ColliderStore()
+{ }
+
+ColliderHandle ColliderStore::Add(Collider* _collider)
+{
+  ColliderPool& pool = GetPool(_collider->GetType());
+
+  //reuse a free slot if there is one.
+  unsigned int index;
+  if (!pool.freeSlots.empty())
+  {
+    index = pool.freeSlots.back();
+    pool.freeSlots.pop_back();
+  }
+  else
+  {
+    index = static_cast<unsigned int>(pool.slots.size());
+    pool.slots.push_back({ 0u, 0u });
+  }
+
+  ColliderPool::Slot& slot = pool.slots[index];
+  slot.dense = static_cast<unsigned int>(pool.Size());
+  //skip 0, so a default handle is never valid.
+  if (++slot.generation == 0u) { ++slot.generation; }
+
+  const Vector2& position = _collider->m_position;
+  const Rect& aabb = _collider->m_aabb;
+
+  pool.x.push_back(position.x);
+  pool.y.push_back(position.y);
+  pool.vx.push_back(_collider->m_velocity.x);
+  pool.vy.push_back(_collider->m_velocity.y);
+  pool.invMass.push_back(_collider->m_invMass);
+
+  pool.minX.push_back(aabb.min.x);
+  pool.minY.push_back(aabb.min.y);
+  pool.maxX.push_back(aabb.max.x);
+  pool.maxY.push_back(aabb.max.y);
+
+  //none of the shapes rotate, so the bounds keep the same offset.
+  pool.localMinX.push_back(aabb.min.x - position.x);
+  pool.localMinY.push_back(aabb.min.y - position.y);
+  pool.localMaxX.push_back(aabb.max.x - position.x);
+  pool.localMaxY.push_back(aabb.max.y - position.y);
+
+  pool.objects.push_back(_collider);
+  pool.owners.push_back(index);
+
+  //keep the awake colliders together at the front.
+  if (_collider->IsAwake())
+  {
+    Swap(pool, pool.Size() - 1u, pool.awake);
+    ++pool.awake;
+  }
+
+  ColliderHandle handle;
+  handle.index = index;
+  handle.generation = slot.generation;
+  handle.type = _collider->GetType();
+  return handle;
+}
+
+bool ColliderStore::Remove(const ColliderHandle& _handle)
+{
+  if (!IsValid(_handle)) { return false; }
+
+  ColliderPool& pool = GetPool(_handle.type);
+  ColliderPool::Slot& slot = pool.slots[_handle.index];
+
+  size_t dense = slot.dense;
+
+  //keep the awake colliders together at the front.
+  if (dense < pool.awake)
+  {
+    --pool.awake;
+    Swap(pool, dense, pool.awake);
+    dense = pool.awake;
+  }
+
+  //move the last collider into the gap.
+  Swap(pool, dense, pool.Size() - 1u);
+
+  pool.x.pop_back();
+  pool.y.pop_back();
+  pool.vx.pop_back();
+  pool.vy.pop_back();
+  pool.invMass.pop_back();
+  pool.minX.pop_back();
+  pool.minY.pop_back();
+  pool.maxX.pop_back();
+  pool.maxY.pop_back();
+  pool.localMinX.pop_back();
+  pool.localMinY.pop_back();
+  pool.localMaxX.pop_back();
+  pool.localMaxY.pop_back();
+  pool.objects.pop_back();
+  pool.owners.pop_back();
+
+  //invalidate the old handles.
+  if (++slot.generation == 0u) { ++slot.generation; }
+  pool.freeSlots.push_back(_handle.index);
+
+  return true;
+}
+
+bool ColliderStore::IsValid(const ColliderHandle& _handle) const
+{
+  const ColliderPool& pool = GetPool(_handle.type);
+  return _handle.generation != 0u &&
+         _handle.index < pool.slots.size() &&
+         pool.slots[_handle.index].generation == _handle.generation;
+}
+
+Collider* ColliderStore::Get(const ColliderHandle& _handle) const
+{
+  if (!IsValid(_handle)) { return nullptr; }
+
+  const ColliderPool& pool = GetPool(_handle.type);
+  return pool.objects[pool.slots[_handle.index].dense];
+}
+
+void ColliderStore::Clear()
+{
+  //keep the slots, so old handles stay invalid.
+  for (auto& pool : m_pools)
+  {
+    while (!pool.owners.empty())
+    {
+      unsigned int index = pool.owners.back();
+      ColliderHandle handle;
+      handle.index = index;
+      handle.generation = pool.slots[index].generation;
+      handle.type = pool.objects.back()->GetType();
+      Remove(handle);
+    }
+  }
+}
+
+size_t ColliderStore::Size() const
+{
+  size_t size = 0u;
+  for (auto& pool : m_pools)
+  {
+    size += pool.Size();
+  }
+  return size;
+}
+
+const ColliderPool& ColliderStore::GetPool(ColliderType _type) const
+{
+  return m_pools[static_cast<int>(_type)];
+}
+
+ColliderPool& ColliderStore::GetPool(ColliderType _type)
+{
+  return m_pools[static_cast<int>(_type)];
+}
+
+void ColliderStore::Integrate(float _deltaTime)
+{
+  for (auto& pool : m_pools)
+  {
+    Integrate(pool, _deltaTime);
+  }
+}
+
+void ColliderStore::Integrate(ColliderPool& _pool, float _deltaTime)
+{
+  //sleeping colliders do not move.
+  //uses the widest instruction set the processor has.
+  Kernels::Get().integrate(_pool, _pool.awake, _deltaTime);
+}
+
+void ColliderStore::Publish()
+{
+  for (auto& pool : m_pools)
+  {
+    for (size_t i = 0; i < pool.awake; ++i)
+    {
+      Collider* collider = pool.objects[i];
+      collider->m_position = Vector2(pool.x[i], pool.y[i]);
+      collider->m_aabb = Rect(pool.minX[i], pool.minY[i], pool.maxX[i], pool.maxY[i]);
+    }
+  }
+}
+
+void ColliderStore::Fatten(float _time)
+{
+  for (auto& pool : m_pools)
+  {
+    for (size_t i = 0; i < pool.awake; ++i)
+    {
+      //the solver can turn the collider any way, so grow every side by as far as it can go,
+      //plus a margin for colliders it pushes from rest.
+      float reach = std::sqrt(pool.vx[i] * pool.vx[i] + pool.vy[i] * pool.vy[i]) * _time + FattenMargin;
+
+      pool.objects[i]->m_aabb = Rect(
+        pool.minX[i] - reach, pool.minY[i] - reach,
+        pool.maxX[i] + reach, pool.maxY[i] + reach);
+    }
+  }
+}
+
+void ColliderStore::Gather()
+{
+  //collision response moves the colliders and changes their velocity.
+  for (auto& pool : m_pools)
+  {
+    Partition(pool);
+
+    for (size_t i = 0; i < pool.awake; ++i)
+    {
+      const Collider* collider = pool.objects[i];
+      pool.x[i] = collider->m_position.x;
+      pool.y[i] = collider->m_position.y;
+      pool.vx[i] = collider->m_velocity.x;
+      pool.vy[i] = collider->m_velocity.y;
+    }
+  }
+}
+
+size_t ColliderStore::GetAwakeCount() const
+{
+  size_t count = 0u;
+  for (auto& pool : m_pools)
+  {
+    count += pool.awake;
+  }
+  return count;
+}
+
+void ColliderStore::Swap(ColliderPool& _pool, size_t _a, size_t _b)
+{
+  if (_a == _b) { return; }
+
+  std::swap(_pool.x[_a], _pool.x[_b]);
+  std::swap(_pool.y[_a], _pool.y[_b]);
+  std::swap(_pool.vx[_a], _pool.vx[_b]);
+  std::swap(_pool.vy[_a], _pool.vy[_b]);
+  std::swap(_pool.invMass[_a], _pool.invMass[_b]);
+  std::swap(_pool.minX[_a], _pool.minX[_b]);
+  std::swap(_pool.minY[_a], _pool.minY[_b]);
+  std::swap(_pool.maxX[_a], _pool.maxX[_b]);
+  std::swap(_pool.maxY[_a], _pool.maxY[_b]);
+  std::swap(_pool.localMinX[_a], _pool.localMinX[_b]);
+  std::swap(_pool.localMinY[_a], _pool.localMinY[_b]);
+  std::swap(_pool.localMaxX[_a], _pool.localMaxX[_b]);
+  std::swap(_pool.localMaxY[_a], _pool.localMaxY[_b]);
+  std::swap(_pool.objects[_a], _pool.objects[_b]);
+  std::swap(_pool.owners[_a], _pool.owners[_b]);
+
+  _pool.slots[_pool.owners[_a]].dense = static_cast<unsigned int>(_a);
+  _pool.slots[_pool.owners[_b]].dense = static_cast<unsigned int>(_b);
+}
+
+void ColliderStore::Partition(ColliderPool& _pool)
+{
+  //move colliders that fell asleep out of the front.
+  size_t i = 0u;
+  while (i < _pool.awake)
+  {
+    if (_pool.objects[i]->IsAwake())
+    {
+      ++i;
+    }
+    else
+    {
+      --_pool.awake;
+      Swap(_pool, i, _pool.awake);
+    }
+  }
+
+  //move colliders that woke up into it.
+  for (i = _pool.awake; i < _pool.Size(); ++i)
+  {
+    if (_pool.objects[i]->IsAwake())
+    {
+      Swap(_pool, i, _pool.awake);
+      ++_pool.awake;
+    }
+  }
+}
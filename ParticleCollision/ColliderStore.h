@@ -0,0 +1,160 @@
+#ifndef _COLLIDERSTORE_H_
+#define _COLLIDERSTORE_H_
+
+#include <vector>
+
+#include "Collider.h"
+
+/**
+ * \brief Stable reference to a collider in a ColliderStore.
+ * The generation changes when a slot is reused, so a handle to a
+ * removed collider is never mistaken for the one that replaced it.
+ */
+
+struct ColliderHandle
+{
+  ColliderHandle() :
+    index(0u), generation(0u), type(ColliderType::AABB)
+  { } //!< Constructor. Makes an invalid handle.
+
+  unsigned int index; //!< Slot in the pool.
+  unsigned int generation; //!< Version of the slot, 0 is never used.
+  ColliderType type; //!< Pool the collider is in.
+};
+
+/**
+ * \brief State of every collider of one type.
+ * Each value is in its own array so a pass can run
+ * over one field of all the colliders at once. Removing
+ * a collider moves the last one into its place. The awake
+ * colliders are kept at the front, so passes that skip
+ * sleeping colliders only run over the first awake entries.
+ */
+
+struct ColliderPool
+{
+  size_t Size() const { return objects.size(); } //!< Get the number of colliders.
+
+  size_t awake = 0u; //!< Number of awake colliders, at the front of the arrays.
+
+  std::vector<float> x, y; //!< Position.
+  std::vector<float> vx, vy; //!< Velocity.
+  std::vector<float> invMass; //!< Inverse mass.
+
+  std::vector<float> minX, minY, maxX, maxY; //!< Bounds in world space.
+  std::vector<float> localMinX, localMinY, localMaxX, localMaxY; //!< Bounds around the position.
+
+  std::vector<Collider*> objects; //!< Collider used by the narrow phase.
+  std::vector<unsigned int> owners; //!< Slot of each collider.
+
+  /**
+   * \brief Where a handle's collider is.
+   */
+  struct Slot
+  {
+    unsigned int dense; //!< Index into the arrays.
+    unsigned int generation; //!< Current version of the slot.
+  };
+
+  std::vector<Slot> slots; //!< Slots by handle index.
+  std::vector<unsigned int> freeSlots; //!< Slots that can be reused.
+};
+
+/**
+ * \brief Data-oriented storage for the colliders' state.
+ * Colliders are kept in a pool for each type. The pools hold the
+ * position, velocity, inverse mass and bounds, and integrating all
+ * of them is a loop over plain arrays instead of a virtual call each.
+ * The collider objects are still used for the shape tests, so the
+ * state is copied to them after integrating and back after the
+ * collisions have been resolved.
+ */
+
+class ColliderStore
+{
+ public:
+  ColliderStore(); //!< Constructor.
+  ~ColliderStore(); //!< Destructor.
+
+  /**
+   * \brief Add a collider to the pool of its type.
+   * \param [in] _collider Collider to store. Not owned by the store.
+   * \return Returns the handle of the collider.
+   */
+  ColliderHandle Add(Collider* _collider);
+
+  /**
+   * \brief Remove a collider.
+   * \param [in] _handle Collider to remove.
+   * \return Returns false if the handle is no longer valid.
+   */
+  bool Remove(const ColliderHandle& _handle);
+
+  bool IsValid(const ColliderHandle& _handle) const; //!< Does the handle's collider still exist?
+
+  Collider* Get(const ColliderHandle& _handle) const; //!< Get a collider, nullptr if the handle is invalid.
+
+  void Clear(); //!< Remove every collider.
+
+  size_t Size() const; //!< Get the total number of colliders.
+
+  const ColliderPool& GetPool(ColliderType _type) const; //!< Get the state of one type.
+  ColliderPool& GetPool(ColliderType _type); //!< Get the state of one type.
+
+  /**
+   * \brief Move every collider and update its bounds.
+   * \param [in] _deltaTime Time to move for.
+   */
+  void Integrate(float _deltaTime);
+
+  void Publish(); //!< Copy the positions and bounds of the awake colliders to the collider objects.
+
+  /**
+   * \brief Grow the published bounds of the awake colliders to cover where they will move.
+   * Lets one broad-phase pass find the pairs for several steps. Every side grows
+   * by the distance the collider can go at its current speed, in any direction, and a
+   * small margin. Sleeping colliders are not integrated until the islands wake them at
+   * the end of the frame, so they keep their bounds.
+   * Call after Publish, the next Publish sets the bounds back.
+   * \param [in] _time Time the colliders will move for at their current velocity.
+   */
+  void Fatten(float _time);
+
+  /**
+   * \brief Copy the positions and velocities back from the collider objects.
+   * Colliders that have been woken or put to sleep since the last
+   * call are moved to the right part of their pool first.
+   */
+  void Gather();
+
+  size_t GetAwakeCount() const; //!< Get the number of awake colliders.
+
+ private:
+  static const int PoolCount = 4; //!< Number of collider types.
+  static const float FattenMargin; //!< Distance added to every side of fattened bounds.
+
+  /**
+   * \brief Move the colliders of one pool.
+   * \param [in, out] _pool      Pool to update.
+   * \param [in]      _deltaTime Time to move for.
+   */
+  static void Integrate(ColliderPool& _pool, float _deltaTime);
+
+  /**
+   * \brief Swap two colliders in a pool, keeping their handles.
+   * \param [in, out] _pool Pool holding the colliders.
+   * \param [in]      _a    Index of the first collider.
+   * \param [in]      _b    Index of the second collider.
+   */
+  static void Swap(ColliderPool& _pool, size_t _a, size_t _b);
+
+  /**
+   * \brief Move the awake colliders to the front of a pool.
+   * \param [in, out] _pool Pool to sort.
+   */
+  static void Partition(ColliderPool& _pool);
+
+  ColliderPool m_pools[PoolCount]; //!< Pool of each collider type.
+};
+
+#endif //_COLLIDERSTORE_H_
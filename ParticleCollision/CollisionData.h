@@ -5,18 +5,53 @@
 
 class Collider;
 
+/**
+ * \brief One point of a collision.
+ */
+
+struct ContactPoint
+{
+ public:
+  Vector2 position; //!< Point in world space.
+  float overlap; //!< Depth at the point along the collision normal.
+  unsigned int id; //!< Features that made the point, the same each frame while they stay touching.
+};
+
 /**
  * \brief Store information about a collision.
+ * Polygon contacts can have up to two points, one at each end of the
+ * face that is touching. The points share the normal.
  */
 
 struct CollisionData
 {
  public:
-  float overlap; //!< Collision depth.
+  static const int MaxPoints = 2; //!< Most points a collision can have.
+
+  float overlap; //!< Collision depth, the deepest of the points.
   Vector2 normal; //!< Normal of the collision from the persective of a.
-  Vector2 position; //!< collision point.
+  Vector2 position; //!< collision point, the middle of the points.
   Collider *a; //!< First collider.
   Collider *b; //!< Second collider.
+
+  ContactPoint points[MaxPoints]; //!< Points of the collision.
+  int pointCount; //!< Number of points used.
+
+  /**
+   * \brief Make the collision a single point.
+   * \param [in] _position Point in world space.
+   * \param [in] _overlap  Depth of the collision.
+   * \param [in] _id       Features that made the point.
+   */
+  void SetPoint(const Vector2& _position, float _overlap, unsigned int _id = 0u)
+  {
+    overlap = _overlap;
+    position = _position;
+    points[0].position = _position;
+    points[0].overlap = _overlap;
+    points[0].id = _id;
+    pointCount = 1;
+  }
 };
 
-#endif //_COLLISIONDATA_H_
\ No newline at end of file
+#endif //_COLLISIONDATA_H_
@@ -9,6 +9,53 @@ CollisionManager::CollisionManager()
 CollisionManager::~CollisionManager()
 { }
 
+void CollisionManager::Draw(Renderer& _renderer)
+{
+  //only walk the structure when the kept rects are out of date.
+  if (m_debugDraw.Begin(_renderer))
+  {
+    DrawDebug(m_debugDraw);
+  }
+  m_debugDraw.Draw(_renderer);
+}
+
+DebugDraw& CollisionManager::GetDebugDraw()
+{
+  return m_debugDraw;
+}
+
+const NarrowPhase& CollisionManager::GetNarrowPhase() const
+{
+  return m_narrowPhase;
+}
+
+ContactSolver& CollisionManager::GetSolver()
+{
+  return m_narrowPhase.GetSolver();
+}
+
+void CollisionManager::SetThreadPool(ThreadPool* _pool)
+{
+  m_narrowPhase.SetThreadPool(_pool);
+  m_narrowPhase.GetSolver().SetThreadPool(_pool);
+}
+
+void CollisionManager::SetKeepGaps(bool _enabled)
+{
+  m_narrowPhase.SetKeepGaps(_enabled);
+}
+
+void CollisionManager::Refit()
+{ }
+
+void CollisionManager::Grow(Collider*)
+{ }
+
+void CollisionManager::CollidePairs()
+{
+  m_narrowPhase.Collide();
+}
+
 void CollisionManager::Collide(Collider &_a, Collider &_b)
 {
   CollisionData data;
@@ -19,6 +66,68 @@ void CollisionManager::Collide(Collider &_a, Collider &_b)
   }
 }
 
+void CollisionManager::QueryPoint(const Vector2& _point, ColliderList& _out)
+{
+  QueryCircle(_point, 0.f, _out);
+}
+
+void CollisionManager::QueryCircle(const Vector2& _centre, float _radius, ColliderList& _out)
+{
+  size_t start = _out.size();
+
+  //get the colliders with bounds around the circle.
+  Vector2 extent(_radius, _radius);
+  QueryRegion(Rect(_centre - extent, _centre + extent), _out);
+
+  //remove the colliders whose shape does not reach the circle.
+  size_t count = start;
+  for (size_t i = start; i < _out.size(); ++i)
+  {
+    if (_out[i]->Distance(_centre) <= _radius)
+    {
+      _out[count++] = _out[i];
+    }
+  }
+  _out.resize(count);
+}
+
+void CollisionManager::QueryRegions(const std::vector<Rect>& _rects, QueryResults& _results)
+{
+  _results.Clear();
+
+  for (auto& rect : _rects)
+  {
+    QueryRegion(rect, _results.items);
+    _results.offsets.push_back(_results.items.size());
+  }
+}
+
+void CollisionManager::QueryCircles(const std::vector<Vector2>& _centres, float _radius, QueryResults& _results)
+{
+  _results.Clear();
+
+  for (auto& centre : _centres)
+  {
+    QueryCircle(centre, _radius, _results.items);
+    _results.offsets.push_back(_results.items.size());
+  }
+}
+
+void CollisionManager::Nearest(const Vector2& _point, float _radius, NearestHeap<Collider>& _heap)
+{
+  Nearest(_point, std::numeric_limits<size_t>().max(), _radius, _heap);
+}
+
+void CollisionManager::Raycasts(const std::vector<Ray>& _rays, std::vector<RayHit>& _hits)
+{
+  _hits.resize(_rays.size());
+
+  for (size_t i = 0; i < _rays.size(); ++i)
+  {
+    Raycast(_rays[i], _hits[i]);
+  }
+}
+
 bool CollisionManager::CollisionOnAxis(Collider& _a, Collider& _b, const Vector2 &_axis)
 {
   Range ar = _a.MinMaxOnAxis(_axis);
@@ -41,12 +150,12 @@ bool CollisionManager::CheckCollision(Circle& _a, Circle& _b, CollisionData &_da
   {
     _data.a = static_cast<Collider*>(&_a);
     _data.b = static_cast<Collider*>(&_b);
-    //get the amount of overlap (inverse of distance)
-    _data.overlap = Max(-(sqrt(distSq) - rad), 0);
     //prevent division by 0
     if (distSq == 0) { diff.y = 1; }
     //get the collision normal.
     _data.normal = diff.Normalized();
+    //touching at the edge of a, the overlap is the inverse of the distance.
+    _data.SetPoint(_a.m_position - _data.normal * _a.m_radius, Max(-(sqrt(distSq) - rad), 0));
     //say that there has been a collision
     return true;
   }
@@ -57,13 +166,17 @@ bool CollisionManager::CheckCollision(Circle& _a, Circle& _b, CollisionData &_da
 
 bool CollisionManager::CheckCollision(Circle& _a, Polygon& _b, CollisionData &_data)
 {
+  //skip the edges if the circle is outside the polygon's bounding circle.
+  float reach = _a.m_radius + _b.m_shape->GetRadius();
+  if ((_a.m_position - _b.m_position).MagnitudeSq() > reach * reach) { return false; }
+
   bool col = false;
 
   //go through all edges of the polygon.
-  for (size_t i = 1; i < _b.m_points.size() + 1; ++i)
+  for (size_t i = 1; i < _b.GetPointCount() + 1; ++i)
   {
-    const Vector2 v1 = _b.m_position + _b.m_points[i - 1];
-    const Vector2 v2 = _b.m_position + _b.m_points[i % _b.m_points.size()];
+    const Vector2 v1 = _b.m_position + _b.GetPoint(i - 1);
+    const Vector2 v2 = _b.m_position + _b.GetPoint(i % _b.GetPointCount());
 
     Vector2 edge = (v1 - v2).Normalized();
 
@@ -90,10 +203,10 @@ bool CollisionManager::CheckCollision(Circle& _a, Polygon& _b, CollisionData &_d
       {
         _data.a = static_cast<Collider*>(&_b);
         _data.b = static_cast<Collider*>(&_a);
-        //get the overlap
-        _data.overlap = -(dist - _a.m_radius);
         //get the collision normal
         _data.normal = normal;
+        //get the overlap, at the edge of the circle.
+        _data.SetPoint(_a.m_position + normal * _a.m_radius, -(dist - _a.m_radius), static_cast<unsigned int>(i));
         //say that there has been a collision
         col = true;
         continue;
@@ -111,10 +224,10 @@ bool CollisionManager::CheckCollision(Circle& _a, Polygon& _b, CollisionData &_d
       {
         _data.a = static_cast<Collider*>(&_a);
         _data.b = static_cast<Collider*>(&_b);
-        //get the overlap
-        _data.overlap = -(sqrt(distSq) - _a.m_radius);
         //get the collision normal
         _data.normal = diff.Normalized();
+        //get the overlap, at the vertex.
+        _data.SetPoint(v1, -(sqrt(distSq) - _a.m_radius), static_cast<unsigned int>(i + _b.GetPointCount()));
         //say that there has been a collision
         col = true;
         continue;
@@ -147,10 +260,10 @@ bool CollisionManager::CheckCollision(Circle& _a, Plane& _b, CollisionData& _dat
     {
       _data.a = static_cast<Collider*>(&_a);
       _data.b = static_cast<Collider*>(&_b);
-      //get the overlap
-      _data.overlap = -dist;
       //get the collision normal
       _data.normal = _b.m_normal;
+      //get the overlap, at the edge of the circle.
+      _data.SetPoint(_a.m_position - _data.normal * _a.m_radius, -dist);
       //say that there has been a collision
       return true;
     }
@@ -179,10 +292,10 @@ bool CollisionManager::CheckCollision(Circle& _a, Plane& _b, CollisionData& _dat
     {
       _data.a = static_cast<Collider*>(&_a);
       _data.b = static_cast<Collider*>(&_b);
-      //get the overlap
-      _data.overlap = -(sqrt(distSq) - _a.m_radius);
       //get the collision normal
       _data.normal = diff.Normalized();
+      //get the overlap, at the end of the plane.
+      _data.SetPoint(_a.m_position - _data.normal * _a.m_radius, -(sqrt(distSq) - _a.m_radius), 1u);
       //say that there has been a collision
       return true;
     }
@@ -194,24 +307,53 @@ bool CollisionManager::CheckCollision(Circle& _a, Plane& _b, CollisionData& _dat
 
 bool CollisionManager::CheckCollision(Polygon& _lhs, Polygon& _rhs, CollisionData& _data)
 {
-  bool collided = false;
+  Vector2 direction = _lhs.m_position - _rhs.m_position;
+
+  //check if the bounding circles are intersecting.
+  float reach = _lhs.m_shape->GetRadius() + _rhs.m_shape->GetRadius();
+  if (direction.MagnitudeSq() > reach * reach) { return false; }
+
+  _data.overlap = std::numeric_limits<float>().max();
 
-  Vector2 direction = (_lhs.m_position - _rhs.m_position).Normalized();
+  //Separate Axis Theorem (SAT)
+  bool collided = CheckEdgeCollisions(_lhs, _rhs, _data);
+
+  //a shared shape has the same axes, so they are already checked.
+  if (collided && _lhs.m_shape != _rhs.m_shape)
+  {
+    collided = CheckEdgeCollisions(_rhs, _lhs, _data);
+  }
 
-  //check if the objects are intersecting in a box aligned to the direction.
-  if (CollisionOnAxis(_lhs, _rhs, direction) &&
-      CollisionOnAxis(_lhs, _rhs, direction.Left()))
+  if (collided)
   {
-    collided = true;
-    _data.overlap = std::numeric_limits<float>().max();
+    //the axes only give a direction up to sign, point the normal from b to a.
+    if (Vector2::Dot(_data.a->m_position - _data.b->m_position, _data.normal) < .0f)
+    {
+      _data.normal = _data.normal * -1.f;
+    }
+
+    //a owns the axis with the least overlap, so its face is the reference.
+    Polygon& reference = static_cast<Polygon&>(*_data.a);
+    Polygon& incident = static_cast<Polygon&>(*_data.b);
+    Vector2 normal = _data.normal * -1.f;
 
-    //Separate Axis Theorem (SAT)
-    
-    collided = CheckEdgeCollisions(_lhs, _rhs, _data);
+    size_t face = FindFace(reference, normal);
+    size_t edge = FindFace(incident, _data.normal);
+    size_t count = reference.GetPointCount();
 
-    if (collided)
+    unsigned int id = FeatureId(face, edge, &reference < &incident);
+    Vector2 r1 = reference.m_position + reference.GetPoint(face);
+    Vector2 r2 = reference.m_position + reference.GetPoint((face + 1) % count);
+
+    count = incident.GetPointCount();
+    Vector2 i1 = incident.m_position + incident.GetPoint(edge);
+    Vector2 i2 = incident.m_position + incident.GetPoint((edge + 1) % count);
+
+    if (ClipManifold(r1, r2, normal, i1, i2, id, _data) == 0)
     {
-      collided = CheckEdgeCollisions(_rhs, _lhs, _data);
+      //no part of the incident face is beside and behind the reference face, use its deeper end.
+      Vector2 deepest = Vector2::Dot(i1, normal) < Vector2::Dot(i2, normal) ? i1 : i2;
+      _data.SetPoint(deepest, _data.overlap, id);
     }
   }
   return collided;
@@ -219,9 +361,6 @@ bool CollisionManager::CheckCollision(Polygon& _lhs, Polygon& _rhs, CollisionDat
 
 bool CollisionManager::CheckCollision(Polygon& _a, Plane& _b, CollisionData& _data)
 {
-  //TODO: do SAT with each edge of the polygon for accurate collision.
-  //      - problem with width of plane.
-
   //project the polygon on the plane.
   Range r = _a.MinMaxOnAxis(_b.m_normal);
   float pos = Vector2::Dot(_b.m_position, _b.m_normal);
@@ -239,25 +378,182 @@ bool CollisionManager::CheckCollision(Polygon& _a, Plane& _b, CollisionData& _da
       _data.b = static_cast<Collider*>(&_b);
       _data.normal = _b.m_normal;
       _data.overlap = pos - r.min;
+
+      //the plane is the reference face, clip the polygon's face that points into it.
+      size_t face = FindFace(_a, _b.m_normal * -1.f);
+      size_t count = _a.GetPointCount();
+
+      unsigned int id = FeatureId(0u, face, static_cast<Collider*>(&_b) < static_cast<Collider*>(&_a));
+      Vector2 i1 = _a.m_position + _a.GetPoint(face);
+      Vector2 i2 = _a.m_position + _a.GetPoint((face + 1) % count);
+
+      if (ClipManifold(_b.Min(), _b.Max(), _b.m_normal, i1, i2, id, _data) == 0)
+      {
+        //the face is past the end of the plane, use the deepest vertex so the plane still stops it.
+        size_t deepest = 0u;
+        for (size_t i = 1; i < count; ++i)
+        {
+          if (Vector2::Dot(_a.GetPoint(i), _b.m_normal) < Vector2::Dot(_a.GetPoint(deepest), _b.m_normal))
+          {
+            deepest = i;
+          }
+        }
+        _data.SetPoint(_a.m_position + _a.GetPoint(deepest), pos - r.min, FeatureId(1u, deepest, false));
+      }
       return true;
     }
   }
   return false;
 }
 
+float CollisionManager::Separation(const Circle& _a, const Polygon& _b)
+{
+  //the bounding circles give a gap along the line between the centres.
+  float gap = (_a.m_position - _b.m_position).Magnitude() - _a.m_radius - _b.m_shape->GetRadius();
+
+  for (size_t i = 0; i < _b.m_shape->GetAxisCount(); ++i)
+  {
+    gap = Max(gap, Range::Distance(_a.MinMaxOnAxis(_b.m_shape->GetAxis(i)), _b.GetProjection(i)));
+  }
+
+  return Max(gap, .0f);
+}
+
+float CollisionManager::Separation(const Polygon& _a, const Polygon& _b)
+{
+  float gap = (_a.m_position - _b.m_position).Magnitude() - _a.m_shape->GetRadius() - _b.m_shape->GetRadius();
+
+  for (size_t i = 0; i < _a.m_shape->GetAxisCount(); ++i)
+  {
+    gap = Max(gap, Range::Distance(_a.GetProjection(i), _b.MinMaxOnAxis(_a.m_shape->GetAxis(i))));
+  }
+  for (size_t i = 0; i < _b.m_shape->GetAxisCount(); ++i)
+  {
+    gap = Max(gap, Range::Distance(_a.MinMaxOnAxis(_b.m_shape->GetAxis(i)), _b.GetProjection(i)));
+  }
+
+  return Max(gap, .0f);
+}
+
+float CollisionManager::Separation(const Polygon& _a, const Plane& _b)
+{
+  //the plane only pushes from the front, so the gap is how far in front the polygon is.
+  float gap = _a.MinMaxOnAxis(_b.m_normal).min - Vector2::Dot(_b.m_position, _b.m_normal);
+
+  //or how far past the end of the plane.
+  Vector2 edge = _b.m_normal.Right();
+  gap = Max(gap, Range::Distance(_a.MinMaxOnAxis(edge), _b.MinMaxOnAxis(edge)));
+
+  return Max(gap, .0f);
+}
+
+size_t CollisionManager::FindFace(const Polygon& _polygon, const Vector2& _direction)
+{
+  size_t count = _polygon.GetPointCount();
+  size_t best = 0u;
+  float bestDot = -std::numeric_limits<float>::max();
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    Vector2 v1 = _polygon.GetPoint(i);
+    Vector2 v2 = _polygon.GetPoint((i + 1) % count);
+
+    //the vertices are around the centre, so the outward normal points away from it.
+    Vector2 normal = (v2 - v1).Left();
+    if (Vector2::Dot(normal, v1 + v2) < .0f) { normal = normal * -1.f; }
+
+    float dot = Vector2::Dot(normal.Normalized(), _direction);
+    if (dot > bestDot)
+    {
+      bestDot = dot;
+      best = i;
+    }
+  }
+
+  return best;
+}
+
+unsigned int CollisionManager::FeatureId(size_t _reference, size_t _incident, bool _flip)
+{
+  return static_cast<unsigned int>(_reference & 0xFFu) |
+         static_cast<unsigned int>(_incident & 0xFFu) << 8u |
+         (_flip ? 1u << 24u : 0u);
+}
+
+int CollisionManager::ClipManifold(const Vector2& _r1, const Vector2& _r2, const Vector2& _normal,
+                                   const Vector2& _i1, const Vector2& _i2, unsigned int _id, CollisionData& _data)
+{
+  //the sides of the reference face.
+  Vector2 tangent = (_r2 - _r1).Normalized();
+  float min = Vector2::Dot(_r1, tangent);
+  float max = Vector2::Dot(_r2, tangent);
+
+  Vector2 points[2] = { _i1, _i2 };
+  unsigned int clipped[2] = { 0u, 0u };
+
+  //clip the incident face against each side of the reference face in turn.
+  for (unsigned int side = 0u; side < 2u; ++side)
+  {
+    //how far each end is inside the side, negative if past it.
+    float e1 = side == 0u ? Vector2::Dot(points[0], tangent) - min : max - Vector2::Dot(points[0], tangent);
+    float e2 = side == 0u ? Vector2::Dot(points[1], tangent) - min : max - Vector2::Dot(points[1], tangent);
+
+    //the whole face is past the side, none of it is beside the reference face.
+    if (e1 < .0f && e2 < .0f) { return 0; }
+
+    //the face crosses the side, move the end that is past it to the crossing.
+    if (e1 < .0f || e2 < .0f)
+    {
+      int out = e1 < .0f ? 0 : 1;
+      points[out] = points[0] + (points[1] - points[0]) * (e1 / (e1 - e2));
+      clipped[out] = side + 1u;
+    }
+  }
+
+  //keep the ends that are behind the reference face.
+  float face = Vector2::Dot(_r1, _normal);
+  int count = 0;
+  Vector2 middle;
+  float deepest = .0f;
+
+  for (int i = 0; i < 2; ++i)
+  {
+    float overlap = face - Vector2::Dot(points[i], _normal);
+    if (overlap < .0f) { continue; }
+
+    ContactPoint& point = _data.points[count++];
+    point.position = points[i];
+    point.overlap = overlap;
+    point.id = _id | static_cast<unsigned int>(i) << 16u | clipped[i] << 20u;
+
+    middle += points[i];
+    deepest = Max(deepest, overlap);
+  }
+
+  if (count > 0)
+  {
+    _data.pointCount = count;
+    _data.position = middle * (1.f / count);
+    _data.overlap = deepest;
+  }
+  return count;
+}
+
 bool CollisionManager::CheckEdgeCollisions(Polygon& _a, Polygon& _b, CollisionData& _data)
 {
   bool collided = true;
 
-  //go through all the edges of a.
-  for (size_t i = 1; i < _a.m_points.size() + 1; i++)
+  //polygons with the same shape have the same range on its axes.
+  bool shared = _a.m_shape == _b.m_shape;
+
+  //go through the separating axes of a.
+  for (size_t i = 0; i < _a.m_shape->GetAxisCount(); i++)
   {
-    //get the normal of the edge.
-    Vector2 normal = (_a.m_points[i - 1] - _a.m_points[i % _a.m_points.size()]).Normalized().Left();
+    const Vector2& normal = _a.m_shape->GetAxis(i);
 
-    //get the size of each polygon on the edge.
-    Range lr = _a.MinMaxOnAxis(normal);
-    Range rr = _b.MinMaxOnAxis(normal);
+    //get the size of each polygon on the axis.
+    Range lr = _a.GetProjection(i);
+    Range rr = shared ? _b.GetProjection(i) : _b.MinMaxOnAxis(normal);
 
     if (Range::Overlaps(lr, rr))
     {
@@ -282,6 +578,147 @@ bool CollisionManager::CheckEdgeCollisions(Polygon& _a, Polygon& _b, CollisionDa
   return collided;
 }
 
+bool CollisionManager::Raycast(const Ray& _ray, const Circle& _circle, float _maxDistance, RayHit& _hit)
+{
+  return RaycastPoint(_ray, _circle.m_position, _circle.m_radius, _maxDistance, _hit);
+}
+
+bool CollisionManager::Raycast(const Ray& _ray, const Polygon& _polygon, float _maxDistance, RayHit& _hit)
+{
+  //if the ray starts inside, it hits straight away.
+  if (_polygon.Distance(_ray.origin) <= .0f)
+  {
+    _hit.distance = .0f;
+    _hit.point = _ray.origin;
+    _hit.normal = _ray.direction * -1.f;
+    return true;
+  }
+
+  bool hit = false;
+
+  //find the closest edge hit.
+  for (size_t i = 1; i < _polygon.GetPointCount() + 1; ++i)
+  {
+    const Vector2 v1 = _polygon.m_position + _polygon.GetPoint(i - 1);
+    const Vector2 v2 = _polygon.m_position + _polygon.GetPoint(i % _polygon.GetPointCount());
+
+    if (RaycastEdge(_ray, v1, v2, _maxDistance, _hit))
+    {
+      _maxDistance = _hit.distance;
+      hit = true;
+    }
+  }
+
+  return hit;
+}
+
+bool CollisionManager::Raycast(const Ray& _ray, const Plane& _plane, float _maxDistance, RayHit& _hit)
+{
+  return RaycastEdge(_ray, _plane.Min(), _plane.Max(), _maxDistance, _hit);
+}
+
+bool CollisionManager::RaycastPoint(const Ray& _ray, const Vector2& _centre, float _radius, float _maxDistance, RayHit& _hit)
+{
+  //the swept circle touches the point when its centre is within both radii.
+  float radius = _radius + _ray.radius;
+
+  Vector2 diff = _ray.origin - _centre;
+  float b = Vector2::Dot(diff, _ray.direction);
+  float c = diff.MagnitudeSq() - radius * radius;
+
+  float distance = .0f;
+
+  //if the ray does not start inside, solve for the entry point.
+  if (c > .0f)
+  {
+    //moving away from the point.
+    if (b > .0f) { return false; }
+
+    float discriminant = b * b - c;
+    if (discriminant < .0f) { return false; }
+
+    distance = -b - sqrt(discriminant);
+  }
+
+  if (distance > _maxDistance) { return false; }
+
+  Vector2 normal = _ray.GetPoint(distance) - _centre;
+  float length = normal.Magnitude();
+
+  _hit.distance = distance;
+  _hit.normal = length > .0f ? normal * (1.f / length) : _ray.direction * -1.f;
+  _hit.point = _centre + _hit.normal * _radius;
+  return true;
+}
+
+bool CollisionManager::RaycastEdge(const Ray& _ray, const Vector2& _a, const Vector2& _b, float _maxDistance, RayHit& _hit)
+{
+  bool hit = false;
+
+  Vector2 edge = _b - _a;
+  float length = edge.Magnitude();
+
+  if (length > .0f)
+  {
+    Vector2 dir = edge * (1.f / length);
+
+    //use the normal facing the start of the ray.
+    Vector2 normal = dir.Left();
+    float side = Vector2::Dot(_ray.origin - _a, normal);
+    if (side < .0f)
+    {
+      normal = normal * -1.f;
+      side = -side;
+    }
+
+    //if the ray starts touching the edge, it hits straight away.
+    float along = Vector2::Dot(_ray.origin - _a, dir);
+    if (side <= _ray.radius && along >= .0f && along <= length)
+    {
+      _hit.distance = .0f;
+      _hit.normal = normal;
+      _hit.point = _a + dir * along;
+      return true;
+    }
+
+    //get where the swept circle reaches the edge's line.
+    //if it starts closer than its radius, it can only hit the ends.
+    float speed = Vector2::Dot(_ray.direction, normal);
+    if (speed < .0f && side > _ray.radius)
+    {
+      float distance = (side - _ray.radius) / -speed;
+      if (distance <= _maxDistance)
+      {
+        Vector2 point = _ray.GetPoint(distance) - normal * _ray.radius;
+        float t = Vector2::Dot(point - _a, dir);
+
+        //check the point is within the edge.
+        if (t >= .0f && t <= length)
+        {
+          _hit.distance = distance;
+          _hit.normal = normal;
+          _hit.point = point;
+          _maxDistance = distance;
+          hit = true;
+        }
+      }
+    }
+  }
+
+  //check the rounded ends of the swept edge.
+  if (RaycastPoint(_ray, _a, .0f, _maxDistance, _hit))
+  {
+    _maxDistance = _hit.distance;
+    hit = true;
+  }
+  if (RaycastPoint(_ray, _b, .0f, _maxDistance, _hit))
+  {
+    hit = true;
+  }
+
+  return hit;
+}
+
 void CollisionManager::ResolveCollision(Collider& _a, Collider& _b, const CollisionData& _data)
 {
   //get the total mass
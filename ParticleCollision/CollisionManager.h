@@ -10,6 +10,10 @@
 #include "Plane.h"
 
 #include "CollisionData.h"
+#include "QueryResults.h"
+#include "NearestHeap.h"
+#include "DebugDraw.h"
+#include "NarrowPhase.h"
 
 enum class BroadPhaseType
 {
@@ -31,10 +35,133 @@ class CollisionManager
   virtual void Reset() = 0;
 
   virtual void Collide() = 0;
-  virtual void Draw(Renderer& _renderer) = 0;
+
+  /**
+   * \brief Check and resolve the pairs found by the last Collide again.
+   * Used for sub-steps, so the broad-phase only runs once a frame. The
+   * pairs are only right if the bounds given to the broad-phase
+   * covered the moves of all the sub-steps.
+   */
+  void CollidePairs();
+
+  /**
+   * \brief Draw the broad-phase structure.
+   * The rects are only collected again when the debug draw
+   * interval has passed or the view has changed.
+   * \param [in, out] _renderer Renderer to draw to.
+   */
+  void Draw(Renderer& _renderer);
+
+  /**
+   * \brief Add the rects of the broad-phase structure.
+   * \param [in, out] _debug Culls and stores the rects.
+   */
+  virtual void DrawDebug(DebugDraw& _debug) = 0;
+
+  DebugDraw& GetDebugDraw(); //!< Get the options for drawing the broad-phase.
+
+  const NarrowPhase& GetNarrowPhase() const; //!< Get the pairs and collisions of the last update.
+
+  ContactSolver& GetSolver(); //!< Get the options for resolving the collisions.
+
+  /**
+   * \brief Check and resolve the pairs on threads.
+   * \param [in] _pool Threads to use, nullptr runs on the calling thread.
+   */
+  void SetThreadPool(ThreadPool* _pool);
+
+  void SetKeepGaps(bool _enabled); //!< Skip the pairs the narrow phase knows are too far apart to touch.
 
   virtual void Insert(const std::shared_ptr<Collider>& _collider) = 0;
 
+  /**
+   * \brief Bring the broad-phase up to date with the colliders' bounds.
+   * Broad-phases that are built by Insert are already up to date, the
+   * others only catch up in Collide. Call before querying between the
+   * two.
+   */
+  virtual void Refit();
+
+  /**
+   * \brief Let the broad-phase know a collider's bounds have grown since it was inserted.
+   * Broad-phases that refit in Collide pick up the change themselves.
+   * \param [in] _collider Collider whose bounds now cover more than when inserted.
+   */
+  virtual void Grow(Collider* _collider);
+
+  /**
+   * \brief Find the colliders with a bounding box overlapping an area.
+   * Uses the state of the broad-phase from the last update.
+   * \param [in]  _rect Area to search.
+   * \param [out] _out  List to append the colliders to.
+   */
+  virtual void QueryRegion(const Rect& _rect, ColliderList& _out) = 0;
+
+  /**
+   * \brief Find the colliders that contain a point.
+   * \param [in]  _point Position to search.
+   * \param [out] _out   List to append the colliders to.
+   */
+  void QueryPoint(const Vector2& _point, ColliderList& _out);
+
+  /**
+   * \brief Find the colliders that overlap a circle.
+   * \param [in]  _centre Centre of the circle.
+   * \param [in]  _radius Size of the circle.
+   * \param [out] _out    List to append the colliders to.
+   */
+  void QueryCircle(const Vector2& _centre, float _radius, ColliderList& _out);
+
+  /**
+   * \brief Run a region query for each area.
+   * \param [in]  _rects   Areas to search.
+   * \param [out] _results Colliders found for each area.
+   */
+  void QueryRegions(const std::vector<Rect>& _rects, QueryResults& _results);
+
+  /**
+   * \brief Run a circle query for each position.
+   * \param [in]  _centres Centres of the circles.
+   * \param [in]  _radius  Size of the circles.
+   * \param [out] _results Colliders found for each circle.
+   */
+  void QueryCircles(const std::vector<Vector2>& _centres, float _radius, QueryResults& _results);
+
+  /**
+   * \brief Find the closest colliders to a point.
+   * \param [in]      _point       Position to search from.
+   * \param [in]      _count       Maximum number of colliders to find.
+   * \param [in]      _maxDistance Ignore colliders further than this.
+   * \param [in, out] _heap        Search storage, reused between searches. Holds the
+   *                               colliders found, closest first.
+   */
+  virtual void Nearest(const Vector2& _point, size_t _count, float _maxDistance, NearestHeap<Collider>& _heap) = 0;
+
+  /**
+   * \brief Find all the colliders within a distance of a point.
+   * \param [in]      _point  Position to search from.
+   * \param [in]      _radius Distance to search.
+   * \param [in, out] _heap   Search storage, reused between searches. Holds the
+   *                          colliders found, closest first.
+   */
+  void Nearest(const Vector2& _point, float _radius, NearestHeap<Collider>& _heap);
+
+  /**
+   * \brief Find the closest collider hit by a ray.
+   * Give the ray a radius to sweep a circle.
+   * \param [in]  _ray Ray to cast.
+   * \param [out] _hit Information about the closest hit.
+   * \return Returns true if the ray hits a collider.
+   */
+  virtual bool Raycast(const Ray& _ray, RayHit& _hit) = 0;
+
+  /**
+   * \brief Find the closest collider hit by each ray.
+   * \param [in]  _rays Rays to cast.
+   * \param [out] _hits Closest hit of each ray. The collider is nullptr for a miss.
+   */
+  virtual void Raycasts(const std::vector<Ray>& _rays, std::vector<RayHit>& _hits);
+
   /**
    * \brief Do collision check and response.
    * \param [in, out] _lhs
@@ -96,6 +223,32 @@ class CollisionManager
    */
   static bool CheckCollision(Polygon& _a, Plane& _b, CollisionData& _data);
 
+  /**
+   * \brief Get a lower bound on the distance between a circle and a polygon.
+   * Colliders only move, so they cannot touch until one has moved
+   * this far relative to the other.
+   * \param [in] _a
+   * \param [in] _b
+   * \return Returns the widest gap on the separating axes, 0 if none separate them.
+   */
+  static float Separation(const Circle& _a, const Polygon& _b);
+
+  /**
+   * \brief Get a lower bound on the distance between two polygons.
+   * \param [in] _a
+   * \param [in] _b
+   * \return Returns the widest gap on the separating axes, 0 if none separate them.
+   */
+  static float Separation(const Polygon& _a, const Polygon& _b);
+
+  /**
+   * \brief Get a lower bound on the distance between a polygon and a plane.
+   * \param [in] _a
+   * \param [in] _b
+   * \return Returns the gap in front of or past the end of the plane, 0 if they could touch.
+   */
+  static float Separation(const Polygon& _a, const Plane& _b);
+
   /**
    * \brief Check all the edge normals of polygon a with b.
    * \param [in]  _a    Polygon with edge checks.
@@ -105,6 +258,89 @@ class CollisionManager
    */
   static bool CheckEdgeCollisions(Polygon& _a, Polygon& _b, CollisionData& _data);
 
+  /**
+   * \brief Find the face of a polygon that points most along a direction.
+   * \param [in] _polygon   Polygon to search.
+   * \param [in] _direction Direction to match.
+   * \return Returns the index of the face, from that vertex to the next.
+   */
+  static size_t FindFace(const Polygon& _polygon, const Vector2& _direction);
+
+  /**
+   * \brief Make an id for the features of a contact point.
+   * \param [in] _reference Face of the reference shape.
+   * \param [in] _incident  Face of the incident shape.
+   * \param [in] _flip      Which collider is the reference, so swapping them gives a new id.
+   * \return Returns the id, without the end of the face.
+   */
+  static unsigned int FeatureId(size_t _reference, size_t _incident, bool _flip);
+
+  /**
+   * \brief Clip the incident face to the reference face to make the contact points.
+   * \param [in]      _r1     Start of the reference face.
+   * \param [in]      _r2     End of the reference face.
+   * \param [in]      _normal Outward normal of the reference face.
+   * \param [in]      _i1     Start of the incident face.
+   * \param [in]      _i2     End of the incident face.
+   * \param [in]      _id     Id of the faces, from FeatureId.
+   * \param [in, out] _data   Gets the points behind the reference face. Left alone if there are none.
+   * \return Returns the number of points.
+   */
+  static int ClipManifold(const Vector2& _r1, const Vector2& _r2, const Vector2& _normal,
+                          const Vector2& _i1, const Vector2& _i2, unsigned int _id, CollisionData& _data);
+
+  /**
+   * \brief Check if a ray hits a circle.
+   * \param [in]  _ray         Ray to cast.
+   * \param [in]  _circle      Circle to check.
+   * \param [in]  _maxDistance Ignore hits further than this.
+   * \param [out] _hit         Information about the hit.
+   * \return Returns true if the ray hits.
+   */
+  static bool Raycast(const Ray& _ray, const Circle& _circle, float _maxDistance, RayHit& _hit);
+
+  /**
+   * \brief Check if a ray hits a polygon.
+   * \param [in]  _ray         Ray to cast.
+   * \param [in]  _polygon     Polygon to check.
+   * \param [in]  _maxDistance Ignore hits further than this.
+   * \param [out] _hit         Information about the hit.
+   * \return Returns true if the ray hits.
+   */
+  static bool Raycast(const Ray& _ray, const Polygon& _polygon, float _maxDistance, RayHit& _hit);
+
+  /**
+   * \brief Check if a ray hits a plane.
+   * \param [in]  _ray         Ray to cast.
+   * \param [in]  _plane       Plane to check.
+   * \param [in]  _maxDistance Ignore hits further than this.
+   * \param [out] _hit         Information about the hit.
+   * \return Returns true if the ray hits.
+   */
+  static bool Raycast(const Ray& _ray, const Plane& _plane, float _maxDistance, RayHit& _hit);
+
+  /**
+   * \brief Check if a ray hits a point grown by a radius.
+   * \param [in]  _ray         Ray to cast.
+   * \param [in]  _centre      Position of the point.
+   * \param [in]  _radius      Size around the point.
+   * \param [in]  _maxDistance Ignore hits further than this.
+   * \param [out] _hit         Information about the hit.
+   * \return Returns true if the ray hits.
+   */
+  static bool RaycastPoint(const Ray& _ray, const Vector2& _centre, float _radius, float _maxDistance, RayHit& _hit);
+
+  /**
+   * \brief Check if a ray hits a line segment.
+   * \param [in]  _ray         Ray to cast.
+   * \param [in]  _a           Start of the edge.
+   * \param [in]  _b           End of the edge.
+   * \param [in]  _maxDistance Ignore hits further than this.
+   * \param [out] _hit         Information about the hit.
+   * \return Returns true if the ray hits.
+   */
+  static bool RaycastEdge(const Ray& _ray, const Vector2& _a, const Vector2& _b, float _maxDistance, RayHit& _hit);
+
   /**
    * \brief Resolve a collion between to colliders.
    * \param [in, out] _a
@@ -112,6 +348,10 @@ class CollisionManager
    * \param [in]      _data Information about the collision.
    */
   static void ResolveCollision(Collider& _a, Collider& _b, const CollisionData& _data);
+
+ protected:
+  DebugDraw m_debugDraw; //!< Rects of the broad-phase to draw.
+  NarrowPhase m_narrowPhase; //!< Checks the pairs found by the broad-phase.
 };
 
 #endif //_COLLISIONMANAGER_H_
\ No newline at end of file
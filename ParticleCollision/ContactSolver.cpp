@@ -0,0 +1,447 @@
+#include "ContactSolver.h"
+
+#include <functional>
+#include <algorithm>
+
+#include "Collider.h"
+#include "ThreadPool.h"
+
+const float ContactSolver::Slop = .01f;
+const float ContactSolver::Correction = .8f;
+const float ContactSolver::BounceThreshold = 1.f;
+const size_t ContactSolver::MaxColors;
+const size_t ContactSolver::BatchSize;
+const unsigned int ContactSolver::NoBody;
+
+ContactSolver::PairKey::PairKey(const Collider* _a, const Collider* _b, unsigned int _id) :
+  a(_a < _b ? _a : _b),
+  b(_a < _b ? _b : _a),
+  id(_id)
+{ }
+
+size_t ContactSolver::PairHash::operator()(const PairKey& _key) const
+{
+  size_t a = std::hash<const Collider*>()(_key.a);
+  size_t b = std::hash<const Collider*>()(_key.b) ^ (_key.id * 0x85ebca6bu);
+  return a ^ (b + 0x9e3779b9u + (a << 6) + (a >> 2));
+}
+
+ContactSolver::ContactSolver() :
+  m_lanes(),
+  m_velocityIterations(8),
+  m_positionIterations(3),
+  m_warmStarting(true),
+  m_warmCount(0u),
+  m_pool(nullptr),
+  m_deterministic(false)
+{ }
+
+ContactSolver::~ContactSolver()
+{ }
+
+void ContactSolver::Solve(const std::vector<CollisionData>& _contacts)
+{
+  Prepare(_contacts);
+
+  if (m_deterministic)
+  {
+    //the order the pairs were found in no longer matters.
+    //use the collider ids rather than addresses so runs match too.
+    std::sort(m_contacts.begin(), m_contacts.end(), [](const Contact& _lhs, const Contact& _rhs)
+    {
+      unsigned int lhsA = std::min(_lhs.a->GetId(), _lhs.b->GetId());
+      unsigned int lhsB = std::max(_lhs.a->GetId(), _lhs.b->GetId());
+      unsigned int rhsA = std::min(_rhs.a->GetId(), _rhs.b->GetId());
+      unsigned int rhsB = std::max(_rhs.a->GetId(), _rhs.b->GetId());
+      if (lhsA != rhsA) { return lhsA < rhsA; }
+      if (lhsB != rhsB) { return lhsB < rhsB; }
+      return _lhs.id < _rhs.id;
+    });
+  }
+
+  //the kernels need the contacts of a color to not share a moving collider, threaded or not.
+  Color();
+  WarmStart();
+  Gather();
+
+  for (int i = 0; i < m_velocityIterations; ++i)
+  {
+    SolveVelocities();
+  }
+
+  Scatter();
+
+  //stop early once nothing overlaps by more than the slop.
+  for (int i = 0; i < m_positionIterations; ++i)
+  {
+    if (SolvePositions()) { break; }
+  }
+
+  Store();
+}
+
+void ContactSolver::Clear()
+{
+  m_contacts.clear();
+  m_impulses.clear();
+  m_warmCount = 0u;
+}
+
+void ContactSolver::SetIterations(int _velocity, int _position)
+{
+  m_velocityIterations = _velocity < 1 ? 1 : _velocity;
+  m_positionIterations = _position < 0 ? 0 : _position;
+}
+
+int ContactSolver::GetVelocityIterations() const
+{
+  return m_velocityIterations;
+}
+
+int ContactSolver::GetPositionIterations() const
+{
+  return m_positionIterations;
+}
+
+void ContactSolver::SetWarmStarting(bool _enabled)
+{
+  m_warmStarting = _enabled;
+}
+
+bool ContactSolver::GetWarmStarting() const
+{
+  return m_warmStarting;
+}
+
+size_t ContactSolver::GetWarmCount() const
+{
+  return m_warmCount;
+}
+
+void ContactSolver::Prepare(const std::vector<CollisionData>& _contacts)
+{
+  m_contacts.clear();
+  m_warmCount = 0u;
+
+  for (auto& data : _contacts)
+  {
+    Collider& a = *data.a;
+    Collider& b = *data.b;
+
+    //two static colliders cannot be moved apart.
+    float invMass = a.m_invMass + b.m_invMass;
+    if (invMass == .0f) { continue; }
+
+    //bounce off the speed the colliders hit at, before any impulse this frame.
+    //slow contacts do not bounce so resting colliders can settle.
+    float speed = Vector2::Dot(a.m_velocity - b.m_velocity, data.normal);
+    float bounce = a.m_bounciness * b.m_bounciness;
+
+    Contact contact;
+    contact.a = data.a;
+    contact.b = data.b;
+    contact.normal = data.normal;
+    contact.mass = 1.f / invMass;
+    contact.target = speed < -BounceThreshold ? -bounce * speed : .0f;
+    contact.startA = a.m_position;
+    contact.startB = b.m_position;
+
+    for (int i = 0; i < data.pointCount; ++i)
+    {
+      contact.overlap = data.points[i].overlap;
+      contact.id = data.points[i].id;
+      contact.impulse = .0f;
+
+      if (m_warmStarting)
+      {
+        auto it = m_impulses.find(PairKey(data.a, data.b, contact.id));
+        if (it != m_impulses.end())
+        {
+          contact.impulse = it->second;
+          ++m_warmCount;
+        }
+      }
+
+      m_contacts.push_back(contact);
+    }
+  }
+}
+
+void ContactSolver::WarmStart()
+{
+  for (auto& contact : m_contacts)
+  {
+    if (contact.impulse == .0f) { continue; }
+
+    //the impulse is along the normal, so it is the same whichever collider is first.
+    Vector2 impulse = contact.normal * contact.impulse;
+    contact.a->m_velocity += impulse * contact.a->m_invMass;
+    contact.b->m_velocity -= impulse * contact.b->m_invMass;
+  }
+}
+
+void ContactSolver::Color()
+{
+  for (auto& contact : m_contacts)
+  {
+    contact.a->m_colors = 0u;
+    contact.b->m_colors = 0u;
+  }
+
+  size_t counts[MaxColors + 1u] = { };
+  m_colors.resize(m_contacts.size());
+
+  //give each contact the lowest color neither of its moving colliders has.
+  for (size_t i = 0; i < m_contacts.size(); ++i)
+  {
+    Collider& a = *m_contacts[i].a;
+    Collider& b = *m_contacts[i].b;
+
+    unsigned long long used = (a.m_invMass != .0f ? a.m_colors : 0u) |
+                              (b.m_invMass != .0f ? b.m_colors : 0u);
+
+    size_t color = 0u;
+    while (color < MaxColors && (used & (1ull << color)) != 0u) { ++color; }
+
+    if (color < MaxColors)
+    {
+      a.m_colors |= 1ull << color;
+      b.m_colors |= 1ull << color;
+    }
+
+    m_colors[i] = static_cast<unsigned char>(color);
+    ++counts[color];
+  }
+
+  //group the contacts by color, keeping their order within a color.
+  m_colorStarts.resize(MaxColors + 2u);
+  m_colorStarts[0] = 0u;
+  for (size_t color = 0; color <= MaxColors; ++color)
+  {
+    m_colorStarts[color + 1u] = m_colorStarts[color] + counts[color];
+    counts[color] = m_colorStarts[color];
+  }
+
+  m_sorted.resize(m_contacts.size());
+  for (size_t i = 0; i < m_contacts.size(); ++i)
+  {
+    m_sorted[counts[m_colors[i]]++] = m_contacts[i];
+  }
+  m_contacts.swap(m_sorted);
+}
+
+void ContactSolver::Gather()
+{
+  for (auto& contact : m_contacts)
+  {
+    contact.a->m_body = NoBody;
+    contact.b->m_body = NoBody;
+  }
+
+  //give each collider one slot, however many contacts it is in.
+  m_bodies.clear();
+  m_laneA.resize(m_contacts.size());
+  m_laneB.resize(m_contacts.size());
+
+  for (size_t i = 0; i < m_contacts.size(); ++i)
+  {
+    Collider* colliders[2] = { m_contacts[i].a, m_contacts[i].b };
+    for (Collider* collider : colliders)
+    {
+      if (collider->m_body == NoBody)
+      {
+        collider->m_body = static_cast<unsigned int>(m_bodies.size());
+        m_bodies.push_back(collider);
+      }
+    }
+
+    m_laneA[i] = m_contacts[i].a->m_body;
+    m_laneB[i] = m_contacts[i].b->m_body;
+  }
+
+  m_vx.resize(m_bodies.size());
+  m_vy.resize(m_bodies.size());
+  m_invMass.resize(m_bodies.size());
+
+  for (size_t i = 0; i < m_bodies.size(); ++i)
+  {
+    m_vx[i] = m_bodies[i]->m_velocity.x;
+    m_vy[i] = m_bodies[i]->m_velocity.y;
+    m_invMass[i] = m_bodies[i]->m_invMass;
+  }
+
+  m_nx.resize(m_contacts.size());
+  m_ny.resize(m_contacts.size());
+  m_mass.resize(m_contacts.size());
+  m_target.resize(m_contacts.size());
+  m_impulse.resize(m_contacts.size());
+
+  for (size_t i = 0; i < m_contacts.size(); ++i)
+  {
+    m_nx[i] = m_contacts[i].normal.x;
+    m_ny[i] = m_contacts[i].normal.y;
+    m_mass[i] = m_contacts[i].mass;
+    m_target[i] = m_contacts[i].target;
+    m_impulse[i] = m_contacts[i].impulse;
+  }
+
+  m_lanes.vx = m_vx.data();
+  m_lanes.vy = m_vy.data();
+  m_lanes.invMass = m_invMass.data();
+  m_lanes.a = m_laneA.data();
+  m_lanes.b = m_laneB.data();
+  m_lanes.nx = m_nx.data();
+  m_lanes.ny = m_ny.data();
+  m_lanes.mass = m_mass.data();
+  m_lanes.target = m_target.data();
+  m_lanes.impulse = m_impulse.data();
+}
+
+void ContactSolver::Scatter()
+{
+  for (size_t i = 0; i < m_bodies.size(); ++i)
+  {
+    if (m_invMass[i] != .0f)
+    {
+      m_bodies[i]->m_velocity = Vector2(m_vx[i], m_vy[i]);
+    }
+  }
+
+  for (size_t i = 0; i < m_contacts.size(); ++i)
+  {
+    m_contacts[i].impulse = m_impulse[i];
+  }
+}
+
+void ContactSolver::SolveVelocities()
+{
+  const KernelTable& kernels = Kernels::Get();
+
+  //the contacts of a color do not share a moving collider, so its lanes and batches can run at once.
+  for (size_t color = 0; color < MaxColors; ++color)
+  {
+    size_t begin = m_colorStarts[color];
+    size_t end = m_colorStarts[color + 1u];
+
+    if (m_pool == nullptr)
+    {
+      kernels.contacts(m_lanes, begin, end);
+      continue;
+    }
+
+    size_t batches = (end - begin + BatchSize - 1u) / BatchSize;
+    m_pool->ParallelFor(batches, [this, &kernels, begin, end](size_t _batch)
+    {
+      size_t first = begin + _batch * BatchSize;
+      kernels.contacts(m_lanes, first, Min(first + BatchSize, end));
+    });
+  }
+
+  //the contacts that did not get a color share colliders, so they are done in order.
+  GetScalarKernels().contacts(m_lanes, m_colorStarts[MaxColors], m_colorStarts[MaxColors + 1u]);
+}
+
+bool ContactSolver::SolvePositions()
+{
+  float deepest = .0f;
+
+  if (m_pool == nullptr)
+  {
+    deepest = SolvePositions(0u, m_contacts.size());
+  }
+  else
+  {
+    for (size_t color = 0; color < MaxColors; ++color)
+    {
+      size_t begin = m_colorStarts[color];
+      size_t end = m_colorStarts[color + 1u];
+      size_t batches = (end - begin + BatchSize - 1u) / BatchSize;
+
+      //each batch keeps its own deepest overlap so the threads do not share it.
+      m_deepest.assign(batches, .0f);
+      m_pool->ParallelFor(batches, [this, begin, end](size_t _batch)
+      {
+        size_t first = begin + _batch * BatchSize;
+        m_deepest[_batch] = SolvePositions(first, Min(first + BatchSize, end));
+      });
+
+      for (float batch : m_deepest)
+      {
+        deepest = Max(deepest, batch);
+      }
+    }
+
+    deepest = Max(deepest, SolvePositions(m_colorStarts[MaxColors], m_colorStarts[MaxColors + 1u]));
+  }
+
+  return deepest <= Slop * 3.f;
+}
+
+float ContactSolver::SolvePositions(size_t _begin, size_t _end)
+{
+  float deepest = .0f;
+
+  for (size_t i = _begin; i < _end; ++i)
+  {
+    Contact& contact = m_contacts[i];
+    Collider& a = *contact.a;
+    Collider& b = *contact.b;
+
+    //the overlap now, from how far the colliders have moved along the normal.
+    Vector2 moved = (a.m_position - contact.startA) - (b.m_position - contact.startB);
+    float overlap = contact.overlap - Vector2::Dot(moved, contact.normal);
+    deepest = Max(deepest, overlap);
+
+    if (overlap <= Slop) { continue; }
+
+    //move lighter colliders further.
+    Vector2 push = contact.normal * ((overlap - Slop) * Correction * contact.mass);
+    if (a.m_invMass != .0f) { a.m_position += push * a.m_invMass; }
+    if (b.m_invMass != .0f) { b.m_position -= push * b.m_invMass; }
+  }
+
+  return deepest;
+}
+
+void ContactSolver::Store()
+{
+  m_impulses.clear();
+
+  for (auto& contact : m_contacts)
+  {
+    if (contact.impulse > .0f)
+    {
+      m_impulses[PairKey(contact.a, contact.b, contact.id)] = contact.impulse;
+    }
+  }
+}
+
+void ContactSolver::SetThreadPool(ThreadPool* _pool)
+{
+  m_pool = _pool;
+}
+
+ThreadPool* ContactSolver::GetThreadPool() const
+{
+  return m_pool;
+}
+
+void ContactSolver::SetDeterministic(bool _deterministic)
+{
+  m_deterministic = _deterministic;
+}
+
+bool ContactSolver::GetDeterministic() const
+{
+  return m_deterministic;
+}
+
+size_t ContactSolver::GetColorCount() const
+{
+  size_t count = 0u;
+  for (size_t color = 0; color + 1u < m_colorStarts.size(); ++color)
+  {
+    count += m_colorStarts[color + 1u] != m_colorStarts[color];
+  }
+  return count;
+}
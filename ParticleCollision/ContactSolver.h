@@ -0,0 +1,177 @@
+#ifndef _CONTACTSOLVER_H_
+#define _CONTACTSOLVER_H_
+
+#include <vector>
+#include <unordered_map>
+
+#include "CollisionData.h"
+#include "Kernels.h"
+
+class ThreadPool;
+
+/**
+ * \brief Resolve all the collisions of a frame together.
+ * The velocities are solved first, going over every contact a number
+ * of times. Each contact keeps the total impulse it has applied and
+ * the total is clamped so it only ever pushes the colliders apart, so
+ * the order of the contacts matters less the more iterations are run.
+ * Each point of a collision is its own contact. The totals are kept
+ * for the next frame by pair and feature id, and applied up front to the
+ * points that are still touching (warm starting), so a resting pile
+ * starts close to the answer instead of from nothing.
+ * The overlap is then removed in its own pass that only moves the
+ * positions, so pushing the colliders apart does not add energy.
+ * The contacts are split into colors, where no two contacts of a color
+ * share a moving collider. The velocities of the colliders are copied
+ * into arrays and each color is solved by the SIMD kernel, several
+ * contacts at a time, and across the threads if there is a pool.
+ * Static colliders never change, so any number of contacts in a color
+ * can share them.
+ * Keep the object between frames so the storage and impulses are reused.
+ */
+
+class ContactSolver
+{
+ public:
+  ContactSolver(); //!< Constructor.
+  ~ContactSolver(); //!< Destructor.
+
+  /**
+   * \brief Resolve the collisions of a frame.
+   * \param [in] _contacts Collisions found this frame.
+   */
+  void Solve(const std::vector<CollisionData>& _contacts);
+
+  void Clear(); //!< Forget the impulses of the last frame.
+
+  /**
+   * \brief Set the number of passes over the contacts.
+   * \param [in] _velocity Passes solving the velocities, at least 1.
+   * \param [in] _position Passes removing the overlap.
+   */
+  void SetIterations(int _velocity, int _position);
+
+  int GetVelocityIterations() const; //!< Get the passes solving the velocities.
+  int GetPositionIterations() const; //!< Get the passes removing the overlap.
+
+  void SetWarmStarting(bool _enabled); //!< Turn applying the last frame's impulses on or off.
+  bool GetWarmStarting() const; //!< Is the last frame's impulses applied?
+
+  size_t GetWarmCount() const; //!< Get the number of contacts started from the last frame.
+
+  /**
+   * \brief Solve the contacts on threads.
+   * \param [in] _pool Threads to use, nullptr solves them in order on the calling thread.
+   */
+  void SetThreadPool(ThreadPool* _pool);
+  ThreadPool* GetThreadPool() const; //!< Get the threads used, nullptr if solving on the calling thread.
+
+  /**
+   * \brief Sort the contacts before coloring them.
+   * The colors depend on the order the contacts arrive in, sorting them
+   * by collider id gives the same result however the pairs were found.
+   * \param [in] _deterministic Should the contacts be sorted?
+   */
+  void SetDeterministic(bool _deterministic);
+  bool GetDeterministic() const; //!< Are the contacts sorted before coloring?
+
+  size_t GetColorCount() const; //!< Get the number of colors used in the last solve.
+
+ private:
+  static const float Slop; //!< Overlap left alone so resting contacts stay touching.
+  static const float Correction; //!< Fraction of the overlap removed each position pass.
+  static const float BounceThreshold; //!< Closing speed below which colliders do not bounce.
+
+  static const size_t MaxColors = 64; //!< Colors that fit in Collider::m_colors, contacts that do not fit are solved last on one thread.
+  static const size_t BatchSize = 128; //!< Contacts given to a thread at a time, a multiple of the widest kernel.
+  static const unsigned int NoBody = ~0u; //!< Collider::m_body of a collider not yet gathered.
+
+  /**
+   * \brief A contact being solved.
+   */
+  struct Contact
+  {
+    Collider* a; //!< First collider.
+    Collider* b; //!< Second collider.
+    Vector2 normal; //!< Direction from b to a.
+    float overlap; //!< Depth of the point when found.
+    unsigned int id; //!< Features of the point.
+    float mass; //!< Mass along the normal, 1 over the sum of the inverse masses.
+    float target; //!< Separating speed to reach, for the bounce.
+    float impulse; //!< Total impulse applied, never negative.
+    Vector2 startA; //!< Position of a when found.
+    Vector2 startB; //!< Position of b when found.
+  };
+
+  /**
+   * \brief Key of a contact point that is the same whichever collider is first.
+   */
+  struct PairKey
+  {
+    const Collider* a; //!< Lower address.
+    const Collider* b; //!< Higher address.
+    unsigned int id; //!< Features of the point.
+
+    PairKey(const Collider* _a, const Collider* _b, unsigned int _id);
+
+    bool operator==(const PairKey& _other) const { return a == _other.a && b == _other.b && id == _other.id; }
+  };
+
+  /**
+   * \brief Hash of a pair key.
+   */
+  struct PairHash
+  {
+    size_t operator()(const PairKey& _key) const;
+  };
+
+  void Prepare(const std::vector<CollisionData>& _contacts); //!< Set up the contacts, finding the last frame's impulses if enabled.
+  void Color(); //!< Sort the contacts by color, filling m_colorStarts.
+  void WarmStart(); //!< Apply the impulses kept from the last frame.
+
+  void Gather(); //!< Copy the contacts and their colliders' velocities into the lanes.
+  void Scatter(); //!< Copy the velocities and impulses back from the lanes.
+
+  void SolveVelocities(); //!< One pass over the contacts' velocities.
+  bool SolvePositions(); //!< One pass over the contacts' overlap, returns true if all are within the slop.
+
+  /**
+   * \brief Remove the overlap of a range of contacts.
+   * \param [in] _begin First contact.
+   * \param [in] _end   One past the last contact.
+   * \return Returns the deepest overlap before it was removed.
+   */
+  float SolvePositions(size_t _begin, size_t _end);
+
+  void Store(); //!< Keep the impulses for the next frame.
+
+  std::vector<Contact> m_contacts; //!< Contacts of this frame, grouped by color when threaded.
+  std::vector<Contact> m_sorted; //!< Storage for sorting the contacts.
+  std::vector<unsigned char> m_colors; //!< Color of each contact while sorting.
+  std::vector<size_t> m_colorStarts; //!< First contact of each color, and one past the last.
+  std::vector<float> m_deepest; //!< Deepest overlap found by each batch of a position pass.
+
+  std::vector<Collider*> m_bodies; //!< Colliders of the contacts, indexed by Collider::m_body.
+  std::vector<float> m_vx; //!< X velocity of each body while solving.
+  std::vector<float> m_vy; //!< Y velocity of each body while solving.
+  std::vector<float> m_invMass; //!< Inverse mass of each body.
+  std::vector<unsigned int> m_laneA; //!< First body of each contact.
+  std::vector<unsigned int> m_laneB; //!< Second body of each contact.
+  std::vector<float> m_nx; //!< Normal x of each contact.
+  std::vector<float> m_ny; //!< Normal y of each contact.
+  std::vector<float> m_mass; //!< Mass of each contact along the normal.
+  std::vector<float> m_target; //!< Separating speed of each contact.
+  std::vector<float> m_impulse; //!< Total impulse of each contact while solving.
+  ContactLanes m_lanes; //!< Pointers to the arrays above for the kernels.
+  std::unordered_map<PairKey, float, PairHash> m_impulses; //!< Total impulse of each point from the last frame.
+
+  int m_velocityIterations; //!< Passes solving the velocities.
+  int m_positionIterations; //!< Passes removing the overlap.
+  bool m_warmStarting; //!< Apply the last frame's impulses?
+  size_t m_warmCount; //!< Contacts started from the last frame.
+
+  ThreadPool* m_pool; //!< Threads to solve on, nullptr for the calling thread.
+  bool m_deterministic; //!< Sort the contacts before coloring?
+};
+
+#endif //_CONTACTSOLVER_H_
@@ -0,0 +1,175 @@
+#include "ContinuousCollision.h"
+
+#include <algorithm>
+
+#include "Circle.h"
+#include "ColliderStore.h"
+#include "CollisionManager.h"
+
+const int ContinuousCollision::MaxHits;
+const float ContinuousCollision::Threshold = 1.f;
+
+ContinuousCollision::ContinuousCollision() :
+  m_enabled(true),
+  m_hitCount(0u)
+{ }
+
+ContinuousCollision::~ContinuousCollision()
+{ }
+
+void ContinuousCollision::Begin(const ColliderStore& _store, float _deltaTime)
+{
+  m_motions.clear();
+  m_hitCount = 0u;
+
+  if (!m_enabled) { return; }
+
+  //sleeping circles do not move.
+  const ColliderPool& pool = _store.GetPool(ColliderType::CIRCLE);
+  for (size_t i = 0; i < pool.awake; ++i)
+  {
+    Circle* circle = static_cast<Circle*>(pool.objects[i]);
+
+    float reach = circle->GetRadius() * Threshold / _deltaTime;
+    if (pool.vx[i] * pool.vx[i] + pool.vy[i] * pool.vy[i] > reach * reach)
+    {
+      m_motions.push_back({ circle, Vector2(pool.x[i], pool.y[i]) });
+    }
+  }
+}
+
+void ContinuousCollision::Sweep()
+{
+  for (auto& motion : m_motions)
+  {
+    Circle& circle = *motion.circle;
+    Vector2 radius(circle.GetRadius(), circle.GetRadius());
+
+    circle.m_aabb = Rect::Union(circle.m_aabb, Rect(motion.start - radius, motion.start + radius));
+  }
+}
+
+void ContinuousCollision::Resolve(CollisionManager& _manager, float _deltaTime)
+{
+  if (m_motions.empty()) { return; }
+
+  //the swept bounds have to be in the broad-phase before it is searched.
+  _manager.Refit();
+  m_woken.clear();
+
+  for (auto& motion : m_motions)
+  {
+    Circle& circle = *motion.circle;
+    Vector2 start = motion.start;
+    Vector2 end = circle.m_position;
+    float remaining = _deltaTime;
+
+    int hits = 0;
+    for (; hits < MaxHits; ++hits)
+    {
+      RayHit hit;
+      float time;
+      if (!FindHit(_manager, circle, start, end, remaining, hit, time)) { break; }
+
+      if (hits == 0) { ++m_hitCount; }
+
+      //the same impulse as the solver, applied at the time of impact.
+      Collider& other = *hit.collider;
+      float invMass = circle.m_invMass + other.m_invMass;
+      float speed = Vector2::Dot(circle.m_velocity - other.m_velocity, hit.normal);
+
+      if (speed < .0f && invMass > .0f)
+      {
+        //a sleeping collider is not integrated, wake it so the next step moves it.
+        if (other.m_invMass != .0f && !other.IsAwake())
+        {
+          other.SetAwake(true);
+          m_woken.push_back(&other);
+        }
+
+        float bounce = circle.m_bounciness * other.m_bounciness;
+        Vector2 impulse = hit.normal * (-(1.f + bounce) * speed / invMass);
+
+        circle.m_velocity += impulse * circle.m_invMass;
+        if (other.m_invMass != .0f) { other.m_velocity -= impulse * other.m_invMass; }
+      }
+
+      //move to where it touched, then sweep the rest of the frame with the new velocity.
+      start = start + (end - start) * time;
+      remaining *= 1.f - time;
+      end = hits + 1 < MaxHits ? start + circle.m_velocity * remaining : start;
+    }
+
+    if (hits == 0) { continue; }
+
+    //a circle knocked off its path can end outside the bounds it was inserted with.
+    Vector2 radius(circle.GetRadius(), circle.GetRadius());
+    circle.m_position = end;
+    circle.m_aabb = Rect::Union(circle.m_aabb, Rect(end - radius, end + radius));
+    _manager.Grow(&circle);
+  }
+}
+
+bool ContinuousCollision::FindHit(CollisionManager& _manager, const Circle& _circle, const Vector2& _start, const Vector2& _end, float _deltaTime, RayHit& _hit, float& _time)
+{
+  Vector2 path = _end - _start;
+  Vector2 radius(_circle.GetRadius(), _circle.GetRadius());
+  Rect bounds = Rect::Union(Rect(_start - radius, _start + radius), Rect(_end - radius, _end + radius));
+
+  m_found.clear();
+  _manager.QueryRegion(bounds, m_found);
+
+  _hit.collider = nullptr;
+  _time = 1.f;
+
+  for (Collider* other : m_found)
+  {
+    if (other == &_circle) { continue; }
+
+    //sweep in the other collider's frame, so it can be tested where it is now.
+    //colliders woken by a hit this step have a velocity but have not moved yet.
+    bool moved = std::find(m_woken.begin(), m_woken.end(), other) == m_woken.end();
+    Vector2 otherPath = moved ? other->m_velocity * _deltaTime : Vector2();
+    Vector2 relative = path - otherPath;
+    float length = relative.Magnitude();
+    if (length <= .0f) { continue; }
+
+    Ray ray(_start + otherPath, relative * (1.f / length), length, _circle.GetRadius());
+
+    RayHit hit;
+    if (!other->Raycast(ray, length, hit)) { continue; }
+
+    //only stop for colliders it is moving into, not ones it is leaving or sliding along.
+    if (Vector2::Dot(ray.direction, hit.normal) >= .0f) { continue; }
+
+    float time = hit.distance / length;
+    if (time < _time)
+    {
+      _time = time;
+      _hit = hit;
+      _hit.collider = other;
+    }
+  }
+
+  return _hit.collider != nullptr;
+}
+
+void ContinuousCollision::SetEnabled(bool _enabled)
+{
+  m_enabled = _enabled;
+}
+
+bool ContinuousCollision::GetEnabled() const
+{
+  return m_enabled;
+}
+
+size_t ContinuousCollision::GetSweptCount() const
+{
+  return m_motions.size();
+}
+
+size_t ContinuousCollision::GetHitCount() const
+{
+  return m_hitCount;
+}
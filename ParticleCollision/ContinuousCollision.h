@@ -0,0 +1,95 @@
+#ifndef _CONTINUOUSCOLLISION_H_
+#define _CONTINUOUSCOLLISION_H_
+
+#include <vector>
+
+#include "Maths.h"
+#include "Ray.h"
+#include "QueryResults.h"
+
+class Circle;
+class ColliderStore;
+class CollisionManager;
+
+/**
+ * \brief Stop fast circles passing through other colliders.
+ * A circle that moves further than a fraction of its radius in a frame
+ * can jump over a plane or a thin polygon, so neither end of its move
+ * overlaps it. Those circles are found before integrating and their
+ * bounds are grown to cover the whole move, so the broad-phase finds
+ * everything on the way. The circle is then swept along its path with
+ * a ray as wide as it is, against each collider found, relative to the
+ * collider's own move. At the first hit, the circle is put where it
+ * touched, the impulse for the impact is applied and the rest of the
+ * frame is swept again with the new velocity, up to a few hits, so a
+ * circle knocked off another is still stopped by a wall. Slow circles are
+ * left to the discrete checks, so only the few fast ones cost more.
+ */
+
+class ContinuousCollision
+{
+ public:
+  ContinuousCollision(); //!< Constructor.
+  ~ContinuousCollision(); //!< Destructor.
+
+  /**
+   * \brief Find the circles moving fast enough to be swept.
+   * Call before integrating, the positions are kept as the start of each sweep.
+   * \param [in] _store     State of the colliders.
+   * \param [in] _deltaTime Time of the frame.
+   */
+  void Begin(const ColliderStore& _store, float _deltaTime);
+
+  void Sweep(); //!< Grow the bounds of the fast circles to cover their move. Call after publishing the integrated positions.
+
+  /**
+   * \brief Stop each fast circle at the first collider on its path.
+   * Call after the colliders have been inserted, before they are checked.
+   * The broad-phase is told about the circles that end up off their path.
+   * Sleeping colliders that are hit are woken, so they move from the next step.
+   * \param [in] _manager   Broad-phase to search.
+   * \param [in] _deltaTime Time of the frame.
+   */
+  void Resolve(CollisionManager& _manager, float _deltaTime);
+
+  void SetEnabled(bool _enabled); //!< Turn sweeping the fast circles on or off.
+  bool GetEnabled() const; //!< Are the fast circles swept?
+
+  size_t GetSweptCount() const; //!< Get the number of circles swept in the last frame.
+  size_t GetHitCount() const; //!< Get the number of swept circles that hit something in the last frame.
+
+ private:
+  static const int MaxHits = 4; //!< Hits swept in a frame, a circle stops where it touched the last one.
+  static const float Threshold; //!< Fraction of its radius a circle must move in a frame to be swept.
+
+  /**
+   * \brief Find the first collider a circle hits on a move.
+   * \param [in]  _manager   Broad-phase to search.
+   * \param [in]  _circle    Circle to sweep.
+   * \param [in]  _start     Position the move starts from.
+   * \param [in]  _end       Position the move ends at.
+   * \param [in]  _deltaTime Time of the move.
+   * \param [out] _hit       Information about the hit.
+   * \param [out] _time      Fraction of the move before the hit.
+   * \return Returns true if the circle hits something.
+   */
+  bool FindHit(CollisionManager& _manager, const Circle& _circle, const Vector2& _start, const Vector2& _end, float _deltaTime, RayHit& _hit, float& _time);
+
+  /**
+   * \brief The move of a fast circle.
+   */
+  struct Motion
+  {
+    Circle* circle; //!< Circle being swept.
+    Vector2 start; //!< Position before integrating.
+  };
+
+  std::vector<Motion> m_motions; //!< Fast circles of this frame.
+  ColliderList m_found; //!< Colliders near the path of a circle.
+  ColliderList m_woken; //!< Sleeping colliders woken by a hit this step, not yet moved.
+
+  bool m_enabled; //!< Are the fast circles swept?
+  size_t m_hitCount; //!< Swept circles that hit something in the last frame.
+};
+
+#endif //_CONTINUOUSCOLLISION_H_
@@ -0,0 +1,98 @@
+#include "DebugDraw.h"
+
+#include "Renderer.h"
+
+DebugDraw::DebugDraw() :
+  m_scale(0.f),
+  m_frames(0)
+{ }
+
+DebugDraw::~DebugDraw()
+{ }
+
+void DebugDraw::SetSettings(const DebugDrawSettings& _settings)
+{
+  m_settings = _settings;
+  Invalidate();
+}
+
+const DebugDrawSettings& DebugDraw::GetSettings() const
+{
+  return m_settings;
+}
+
+bool DebugDraw::Begin(const Renderer& _renderer)
+{
+  const Vector2& offset = _renderer.GetOffset();
+  float scale = _renderer.GetScale();
+
+  //moving the view changes what is culled.
+  if (offset.x != m_offset.x || offset.y != m_offset.y || scale != m_scale)
+  {
+    Invalidate();
+  }
+
+  //keep drawing the last rects.
+  if (m_frames > 0)
+  {
+    --m_frames;
+    return false;
+  }
+
+  int width, height;
+  _renderer.GetOutputSize(width, height);
+
+  m_offset = offset;
+  m_scale = scale;
+  m_view = Rect(offset, offset + Vector2(width / scale, height / scale));
+
+  m_frames = m_settings.interval > 1 ? m_settings.interval - 1 : 0;
+  m_rects.clear();
+  return true;
+}
+
+bool DebugDraw::ShowNode(const Rect& _rect, int _depth) const
+{
+  return (m_settings.maxDepth < 0 || _depth <= m_settings.maxDepth) &&
+         Visible(_rect) && Large(_rect);
+}
+
+bool DebugDraw::ShowItem(const Rect& _rect) const
+{
+  return m_settings.items && Visible(_rect) && Large(_rect);
+}
+
+bool DebugDraw::Visible(const Rect& _rect) const
+{
+  return Rect::Intersects(_rect, m_view);
+}
+
+const Rect& DebugDraw::GetView() const
+{
+  return m_view;
+}
+
+void DebugDraw::AddRect(const Rect& _rect)
+{
+  m_rects.push_back(_rect);
+}
+
+void DebugDraw::Draw(Renderer& _renderer) const
+{
+  //the rects all go into the renderer's batch.
+  for (auto& rect : m_rects)
+  {
+    rect.Draw(_renderer);
+  }
+}
+
+void DebugDraw::Invalidate()
+{
+  m_frames = 0;
+}
+
+bool DebugDraw::Large(const Rect& _rect) const
+{
+  float size = Max(_rect.Width(), _rect.Height()) * m_scale;
+  return size >= m_settings.minSize;
+}
@@ -0,0 +1,83 @@
+#ifndef _DEBUGDRAW_H_
+#define _DEBUGDRAW_H_
+
+#include <vector>
+
+#include "Rect.h"
+
+/**
+ * \brief Options for drawing the broad-phase structures.
+ */
+
+struct DebugDrawSettings
+{
+  DebugDrawSettings() :
+    maxDepth(-1),
+    minSize(4.f),
+    items(true),
+    interval(1)
+  { } //!< Constructor.
+
+  int maxDepth; //!< Deepest level of nodes to draw, negative draws all of them.
+  float minSize; //!< Smallest rect to draw, in pixels.
+  bool items; //!< Draw the bounds of the items.
+  int interval; //!< Number of frames to keep the rects for.
+};
+
+/**
+ * \brief Collect the rects of a broad-phase structure.
+ * Rects outside the view, too deep or too small on screen are
+ * skipped. The rest are kept in world space and submitted together,
+ * so they can be drawn again for a few frames without walking the
+ * structure.
+ */
+
+class DebugDraw
+{
+ public:
+  DebugDraw(); //!< Constructor.
+  ~DebugDraw(); //!< Destructor.
+
+  void SetSettings(const DebugDrawSettings& _settings); //!< Set the drawing options.
+  const DebugDrawSettings& GetSettings() const; //!< Get the drawing options.
+
+  /**
+   * \brief Start a frame.
+   * \param [in] _renderer Renderer the rects will be drawn to.
+   * \return Returns true if the rects should be collected again.
+   */
+  bool Begin(const Renderer& _renderer);
+
+  /**
+   * \brief Should a node be drawn?
+   * \param [in] _rect  Bounds of the node.
+   * \param [in] _depth Level of the node.
+   */
+  bool ShowNode(const Rect& _rect, int _depth) const;
+
+  bool ShowItem(const Rect& _rect) const; //!< Should the bounds of an item be drawn?
+
+  bool Visible(const Rect& _rect) const; //!< Is the rect inside the view?
+
+  const Rect& GetView() const; //!< Get the area being drawn.
+
+  void AddRect(const Rect& _rect); //!< Add a rect to draw.
+
+  void Draw(Renderer& _renderer) const; //!< Draw the collected rects.
+
+  void Invalidate(); //!< Collect the rects again on the next frame.
+
+ private:
+  bool Large(const Rect& _rect) const; //!< Is the rect big enough on screen?
+
+  DebugDrawSettings m_settings; //!< Drawing options.
+
+  std::vector<Rect> m_rects; //!< Rects to draw, in world space.
+
+  Rect m_view; //!< Area being drawn.
+  Vector2 m_offset; //!< View position the rects were collected at.
+  float m_scale; //!< View scale the rects were collected at.
+  int m_frames; //!< Frames left before collecting again.
+};
+
+#endif //_DEBUGDRAW_H_
@@ -14,6 +14,7 @@
 #include "Maths.h"
 
 #include "Timer.h"
+#include "Kernels.h"
 
 int Game::Run()
 {
@@ -62,13 +63,59 @@ bool Game::Init()
     return false;
   } 
 
-  m_renderer.SetClearColour(240, 240, 240);
+  //circles can still be drawn as outlines without the atlas.
+  if (m_renderer.LoadSprites("resources/images/particle.png") == false)
+  {
+    printf("Unable to create the particle atlas, drawing outlines.\n");
+  }
 
   auto font = std::make_shared<Font>();
   font->Load("resources/fonts/arial.ttf", 24);
 
   m_profiler = std::make_unique<Profiler>(font);
 
+  InitScene();
+
+  return true;
+}
+
+int Game::RunHeadless(int _frames, const std::string& _filename)
+{
+  //nothing is shown, so no subsystems are needed.
+  if (SDL_Init(0) < 0)
+  {
+    printf("Failed to initialise SDL! SDL Error: %s\n", SDL_GetError());
+    return -1;
+  }
+
+  bool success = m_renderer.CreateHeadless(800, 600, m_threads);
+
+  if (success)
+  {
+    srand(time(NULL));
+    InitScene();
+
+    //step at a fixed rate, drawing each frame like the window would.
+    m_deltaTime = 1.f / 60.f;
+    for (int i = 0; i < _frames; ++i)
+    {
+      Update();
+      Render();
+    }
+
+    success = m_renderer.SaveFrame(_filename);
+  }
+
+  m_renderer.Destroy();
+  SDL_Quit();
+
+  return success ? 0 : -1;
+}
+
+void Game::InitScene()
+{
+  m_renderer.SetClearColour(240, 240, 240);
+
   m_spawnRect = Rect(100, 100, 700, 500);
   
   AddPlane(Vector2(100, 600/2), Vector2( 1.0f,  0.0f), 400);
@@ -81,7 +128,15 @@ bool Game::Init()
 
   m_current = &m_quad;
 
-  return true;
+  m_warmStarting = true;
+  m_parallel = true;
+  m_deterministic = false;
+  m_keepGaps = true;
+  m_subSteps = 1;
+
+  ApplyDebugDraw();
+  ApplySolver();
+  ResetCamera();
 }
 
 void Game::Loop()
@@ -108,6 +163,8 @@ void Game::Exit()
 {
   m_profiler.release();
 
+  RemoveColliders();
+
   //destroy the window and renderer
   m_renderer.Destroy();
   m_window.Destroy();
@@ -131,6 +188,12 @@ void Game::HandleEvents()
       case SDL_WINDOWEVENT: { m_window.HandleEvent(e.window); break; }
       //If the close button has been pressed, end the program
       case SDL_QUIT:        { Quit();                         break; } 
+      //zoom the camera with the mouse wheel
+      case SDL_MOUSEWHEEL:
+      {
+        if (e.wheel.y != 0) { m_camera.Zoom(e.wheel.y > 0 ? 1.1f : 1.f / 1.1f); }
+        break;
+      }
       //if a key has been released
       case SDL_KEYUP:
       {
@@ -141,18 +204,21 @@ void Game::HandleEvents()
           case SDL_SCANCODE_1: 
           { 
             m_current = &m_brute; 
+            m_current->GetSolver().Clear();
             ResetProfiler(); 
             break; 
           }
           case SDL_SCANCODE_2:
           { 
             m_current = &m_quad;
+            m_current->GetSolver().Clear();
             ResetProfiler(); 
             break; 
           }
           case SDL_SCANCODE_3: 
           {
             m_current = &m_aabb; 
+            m_current->GetSolver().Clear();
             ResetProfiler();
             break; 
           }
@@ -161,6 +227,87 @@ void Game::HandleEvents()
             ResetProfiler(); 
             break; 
           }
+          case SDL_SCANCODE_S:
+          {
+            m_renderer.SetSprites(!m_renderer.GetSpritesEnabled());
+            break;
+          }
+          case SDL_SCANCODE_F:
+          {
+            m_renderer.SetSoftware(m_renderer.GetSoftware() ? nullptr : &m_threads);
+            break;
+          }
+          case SDL_SCANCODE_I:
+          {
+            m_debugDraw.items = !m_debugDraw.items;
+            ApplyDebugDraw();
+            break;
+          }
+          case SDL_SCANCODE_PAGEUP:
+          {
+            ++m_debugDraw.maxDepth;
+            ApplyDebugDraw();
+            break;
+          }
+          case SDL_SCANCODE_PAGEDOWN:
+          {
+            //-1 draws every level.
+            if (m_debugDraw.maxDepth > -1) { --m_debugDraw.maxDepth; }
+            ApplyDebugDraw();
+            break;
+          }
+          case SDL_SCANCODE_N:
+          {
+            //cycle between collecting every 1, 2, 4, 8 and 16 frames.
+            m_debugDraw.interval = m_debugDraw.interval >= 16 ? 1 : m_debugDraw.interval * 2;
+            ApplyDebugDraw();
+            break;
+          }
+          case SDL_SCANCODE_W:
+          {
+            m_warmStarting = !m_warmStarting;
+            ApplySolver();
+            break;
+          }
+          case SDL_SCANCODE_P:
+          {
+            m_parallel = !m_parallel;
+            ApplySolver();
+            break;
+          }
+          case SDL_SCANCODE_D:
+          {
+            m_deterministic = !m_deterministic;
+            ApplySolver();
+            break;
+          }
+          case SDL_SCANCODE_G:
+          {
+            m_keepGaps = !m_keepGaps;
+            ApplySolver();
+            break;
+          }
+          case SDL_SCANCODE_Z:
+          {
+            m_islands.SetEnabled(!m_islands.GetEnabled());
+            break;
+          }
+          case SDL_SCANCODE_C:
+          {
+            m_continuous.SetEnabled(!m_continuous.GetEnabled());
+            break;
+          }
+          case SDL_SCANCODE_T:
+          {
+            //1, 2, 4 then 8 sub-steps.
+            m_subSteps = m_subSteps < MaxSubSteps ? m_subSteps * 2 : 1;
+            break;
+          }
+          case SDL_SCANCODE_HOME:
+          {
+            ResetCamera();
+            break;
+          }
         }
         break;
       }
@@ -170,25 +317,70 @@ void Game::HandleEvents()
 
 void Game::Update()
 {
-  m_profiler->Update(m_deltaTime);
+  if (m_profiler)
+  {
+    m_profiler->Update(m_deltaTime);
+  }
+
+  float step = m_deltaTime / m_subSteps;
 
   m_current->Reset();
 
-  //update all the particles
+  //move all the particles in one pass over the stored state,
+  //picking up the changes from the last collision response.
+  m_store.Gather();
+  //keep where the fast circles start, so their whole move can be checked.
+  m_continuous.Begin(m_store, step);
+  m_store.Integrate(step);
+  m_store.Publish();
+
+  //the broad-phase only runs on the first sub-step, so its bounds cover the rest of the frame.
+  if (m_subSteps > 1)
+  {
+    m_store.Fatten(m_deltaTime - step);
+  }
+  m_continuous.Sweep();
+
   for (auto& c : m_colliders)
   {
-    //move the particle
-    c->Update(m_deltaTime);
     m_current->Insert(c);
   }
 
+  //stop the fast circles at the first thing in their way, then check everything.
+  m_continuous.Resolve(*m_current, step);
   m_current->Collide();
+
+  //the other sub-steps reuse the pairs found for the frame.
+  for (int i = 1; i < m_subSteps; ++i)
+  {
+    m_store.Gather();
+    m_continuous.Begin(m_store, step);
+    m_store.Integrate(step);
+    m_store.Publish();
+    m_continuous.Sweep();
+
+    m_continuous.Resolve(*m_current, step);
+    m_current->CollidePairs();
+  }
+
+  //sleep the groups that have come to rest, wake the ones that were hit.
+  m_islands.Update(m_store, m_current->GetNarrowPhase().GetContacts(), m_deltaTime);
+
+  UpdateStats();
+  UpdateCamera();
 }
 
 void Game::Render()
 {
   //clear the renderer
   m_renderer.Clear();
+
+  //draw the scene from the camera.
+  int width, height;
+  m_renderer.GetOutputSize(width, height);
+  m_camera.SetViewport(width, height);
+  Rect view = m_camera.GetView();
+  m_renderer.SetView(view.min, m_camera.GetZoom());
   
   m_renderer.SetRenderColour(255, 0, 0);
 
@@ -196,13 +388,19 @@ void Game::Render()
 
   m_renderer.SetRenderColour(0, 0, 0);
 
-  //Draw all the particles.
-  for (auto& c : m_colliders)
+  //only draw the particles the broad-phase finds in view.
+  m_visible.clear();
+  m_current->QueryRegion(view, m_visible);
+
+  for (auto c : m_visible)
   {
     c->Draw(m_renderer);
   }
 
-  m_profiler->Render(m_renderer);
+  if (m_profiler)
+  {
+    m_profiler->Render(m_renderer);
+  }
 
   //Display to the window.
   m_renderer.Render(); 
@@ -232,6 +430,7 @@ void Game::AddPolygons(int _count)
     auto poly = std::make_shared<Polygon>(pos, vel);
     
     m_colliders.emplace_back(poly);  
+    m_handles.push_back(m_store.Add(poly.get()));
     m_aabb.Add(poly);
   }
 }
@@ -254,17 +453,110 @@ void Game::AddCircles(int _count)
     auto circle = std::make_shared<Circle>(pos, vel, 2.f + rand() % 2);
     
     m_colliders.emplace_back(circle);
+    m_handles.push_back(m_store.Add(circle.get()));
     m_aabb.Add(circle);
   }
 }
 
+void Game::RemoveColliders()
+{
+  //the store and the tree only point at the objects, take them out before they are freed.
+  for (size_t i = 0; i < m_colliders.size(); ++i)
+  {
+    m_store.Remove(m_handles[i]);
+    m_aabb.Remove(m_colliders[i].get());
+  }
+
+  m_brute.GetSolver().Clear();
+  m_quad.GetSolver().Clear();
+  m_aabb.GetSolver().Clear();
+
+  m_handles.clear();
+  m_colliders.clear();
+}
+
 void Game::AddPlane(const Vector2 &_position, const Vector2 &_normal, float _width)
 {
   auto p = std::make_shared<Plane>(_position, _normal, _width);
   m_colliders.emplace_back(p);
+  m_handles.push_back(m_store.Add(p.get()));
   m_aabb.Add(p);
 }
 
+void Game::ResetCamera()
+{
+  int width, height;
+  m_renderer.GetOutputSize(width, height);
+  m_camera.SetPosition(Vector2(width * .5f, height * .5f));
+  m_camera.SetZoom(1.f);
+}
+
+void Game::UpdateCamera()
+{
+  const Uint8* keys = SDL_GetKeyboardState(nullptr);
+
+  //move at a constant speed on screen, whatever the zoom.
+  float speed = 400.f / m_camera.GetZoom() * m_deltaTime;
+  Vector2 move;
+
+  if (keys[SDL_SCANCODE_LEFT])  { move.x -= speed; }
+  if (keys[SDL_SCANCODE_RIGHT]) { move.x += speed; }
+  if (keys[SDL_SCANCODE_UP])    { move.y -= speed; }
+  if (keys[SDL_SCANCODE_DOWN])  { move.y += speed; }
+
+  m_camera.Move(move);
+}
+
+void Game::UpdateStats()
+{
+  if (!m_profiler) { return; }
+
+  m_profiler->SetStat(0, "Kernels: %s", Kernels::GetName(Kernels::GetLevel()));
+
+  const ContactSolver& solver = m_current->GetSolver();
+  m_profiler->SetStat(1, "Colors: %zu%s", solver.GetColorCount(), solver.GetDeterministic() ? " (sorted)" : "");
+
+  if (m_continuous.GetEnabled())
+  {
+    m_profiler->SetStat(2, "Swept: %zu Hits: %zu", m_continuous.GetSweptCount(), m_continuous.GetHitCount());
+  }
+  else
+  {
+    m_profiler->SetStat(2, "Swept: off");
+  }
+
+  const NarrowPhase& narrowPhase = m_current->GetNarrowPhase();
+  m_profiler->SetStat(3, "Pairs: %zu Skipped: %zu", narrowPhase.GetPairCount(), narrowPhase.GetSkippedCount());
+}
+
+void Game::ApplyDebugDraw()
+{
+  m_brute.GetDebugDraw().SetSettings(m_debugDraw);
+  m_quad.GetDebugDraw().SetSettings(m_debugDraw);
+  m_aabb.GetDebugDraw().SetSettings(m_debugDraw);
+}
+
+void Game::ApplySolver()
+{
+  ThreadPool* pool = m_parallel ? &m_threads : nullptr;
+
+  m_brute.GetSolver().SetWarmStarting(m_warmStarting);
+  m_quad.GetSolver().SetWarmStarting(m_warmStarting);
+  m_aabb.GetSolver().SetWarmStarting(m_warmStarting);
+
+  m_brute.GetSolver().SetDeterministic(m_deterministic);
+  m_quad.GetSolver().SetDeterministic(m_deterministic);
+  m_aabb.GetSolver().SetDeterministic(m_deterministic);
+
+  m_brute.SetThreadPool(pool);
+  m_quad.SetThreadPool(pool);
+  m_aabb.SetThreadPool(pool);
+
+  m_brute.SetKeepGaps(m_keepGaps);
+  m_quad.SetKeepGaps(m_keepGaps);
+  m_aabb.SetKeepGaps(m_keepGaps);
+}
+
 void Game::ResetProfiler()
 {
   if (m_profiler)
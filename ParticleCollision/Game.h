@@ -13,6 +13,11 @@
 #include "CM_AABBTree.h"
 
 #include "Profiler.h"
+#include "Camera.h"
+#include "ThreadPool.h"
+#include "ColliderStore.h"
+#include "Islands.h"
+#include "ContinuousCollision.h"
 
 /**
  * \brief Manages the application.
@@ -23,10 +28,20 @@ class Game
  public:
   int Run(); //!< Start the application.
 
+  /**
+   * \brief Run the simulation without a window.
+   * The scene is drawn by the software renderer and saved.
+   * \param [in] _frames   Number of frames to simulate.
+   * \param [in] _filename Path of the bitmap to save the last frame to.
+   * \return Returns 0 if the frame was saved.
+   */
+  int RunHeadless(int _frames, const std::string& _filename);
+
   void Quit(); //!< Close the application. Exit the main loop.
 
   void AddPolygons(int _count); //!< Add polygons to the scene.
   void AddCircles(int _count); //!< Add circles to the scene.
+  void RemoveColliders(); //!< Remove every object from the scene and the systems that keep them.
 
   /**
    * \brief Add a plane to the scene.
@@ -37,7 +52,10 @@ class Game
   void AddPlane(const Vector2& _position, const Vector2& _normal, float _width);
 
  private:
+  static const int MaxSubSteps = 8; //!< Most sub-steps a frame can be split into.
+
   bool Init(); //!< Setup the application.
+  void InitScene(); //!< Add the objects to the scene.
   void Loop(); //!< Main loop.
   void Exit(); //!< Shutdown the application.
 
@@ -46,6 +64,11 @@ class Game
   void Render(); //!< Draw all the objects.
 
   void ResetProfiler(); //!< Reset profiler if it exists.
+  void ResetCamera(); //!< Show the whole scene.
+  void UpdateCamera(); //!< Move the camera with the keyboard.
+  void UpdateStats(); //!< Give the systems' statistics to the profiler to show.
+  void ApplyDebugDraw(); //!< Give the debug draw settings to the collision managers.
+  void ApplySolver(); //!< Give the narrow phase and solver settings to the collision managers.
 
   bool m_done; //!< Should the application quit.
 
@@ -54,6 +77,10 @@ class Game
   Window m_window; //!< Window of the application.
   Renderer m_renderer; //!< Renderer to draw to the window.
 
+  ThreadPool m_threads; //!< Workers shared by the systems.
+
+  Camera m_camera; //!< Area of the scene to draw.
+
   CollisionManager* m_current; //!< Current collision manager being used.
 
   CM_BruteForce m_brute; //!< no broad-phase.
@@ -61,6 +88,19 @@ class Game
   CM_AABBTree m_aabb; //!< aabb-tree broad-phase.
 
   std::vector<std::shared_ptr<Collider>> m_colliders; //!< List of objects in the scene.
+  ColliderStore m_store; //!< State of the objects, integrated together.
+  std::vector<ColliderHandle> m_handles; //!< Handle of each object in the store, in the same order as m_colliders.
+  Islands m_islands; //!< Puts resting groups of objects to sleep.
+  ContinuousCollision m_continuous; //!< Stops fast circles passing through other objects.
+
+  ColliderList m_visible; //!< Objects inside the camera's view.
+
+  DebugDrawSettings m_debugDraw; //!< How the broad-phase is drawn.
+  bool m_warmStarting; //!< Do the solvers start from the last frame's impulses?
+  bool m_parallel; //!< Do the narrow phases and solvers use the worker threads?
+  bool m_keepGaps; //!< Do the narrow phases skip pairs too far apart to touch?
+  bool m_deterministic; //!< Do the solvers sort the contacts so the colors do not depend on the order they were found?
+  int m_subSteps; //!< Steps each frame is split into, sharing one broad-phase pass.
 
   Rect m_spawnRect; //!< Area to spawn objects.
 
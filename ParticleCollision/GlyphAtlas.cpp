@@ -0,0 +1,161 @@
+#include "GlyphAtlas.h"
+
+#include <algorithm>
+
+#include "Renderer.h"
+#include "Font.h"
+
+GlyphAtlas::GlyphAtlas() :
+  m_height(0)
+{
+  Destroy();
+}
+
+GlyphAtlas::~GlyphAtlas()
+{ }
+
+bool GlyphAtlas::Create(Renderer& _renderer, const Font& _font)
+{
+  Destroy(); //destroy any existing atlas
+
+  TTF_Font* font = _font.Get();
+  if (font == nullptr) { return false; }
+
+  const int count = Last - First + 1;
+  SDL_Surface* surfaces[count] = { };
+
+  //rasterize the glyphs in white so they can be tinted.
+  SDL_Color white = { 255, 255, 255, 255 };
+  int width = 0, height = 0;
+
+  for (int i = 0; i < count; ++i)
+  {
+    Uint16 c = static_cast<Uint16>(First + i);
+    int minx, maxx, miny, maxy, advance;
+
+    Glyph& glyph = m_glyphs[i];
+    if (TTF_GlyphMetrics(font, c, &minx, &maxx, &miny, &maxy, &advance) < 0)
+    {
+      continue;
+    }
+    //the rendered glyph starts at the pen, or before it if it overhangs.
+    glyph.offset = std::min(minx, 0);
+    glyph.advance = advance;
+
+    surfaces[i] = TTF_RenderGlyph_Blended(font, c, white);
+    if (surfaces[i] == nullptr) { continue; }
+
+    //place the glyphs in one row with a pixel between them.
+    glyph.region = { width + 1, 1, surfaces[i]->w, surfaces[i]->h };
+    width += surfaces[i]->w + 1;
+    height = std::max(height, surfaces[i]->h);
+  }
+
+  SDL_Surface* atlas = SDL_CreateRGBSurface(
+    0, width + 1, height + 2, 32,
+    0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000
+  );
+
+  if (atlas != nullptr)
+  {
+    //copy the pixels as they are instead of blending them.
+    for (int i = 0; i < count; ++i)
+    {
+      if (surfaces[i] == nullptr) { continue; }
+      SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+      SDL_BlitSurface(surfaces[i], nullptr, atlas, &m_glyphs[i].region);
+    }
+  }
+  else
+  {
+    printf("Unable to create glyph atlas surface. SDL Error: %s\n", SDL_GetError());
+  }
+
+  for (int i = 0; i < count; ++i)
+  {
+    SDL_FreeSurface(surfaces[i]);
+  }
+
+  if (atlas == nullptr) { return false; }
+
+  bool success = m_atlas.CreateFromSurface(_renderer, atlas);
+  SDL_FreeSurface(atlas);
+
+  if (!success)
+  {
+    Destroy();
+    return false;
+  }
+
+  SDL_SetTextureBlendMode(m_atlas.Get(), SDL_BLENDMODE_BLEND);
+  m_height = TTF_FontLineSkip(font);
+  return true;
+}
+
+void GlyphAtlas::Destroy()
+{
+  m_quads.Clear();
+  m_atlas.Destroy();
+
+  for (auto& glyph : m_glyphs)
+  {
+    glyph.region = { 0, 0, 0, 0 };
+    glyph.offset = glyph.advance = 0;
+  }
+  m_height = 0;
+}
+
+bool GlyphAtlas::IsCreated() const
+{
+  return m_height > 0;
+}
+
+void GlyphAtlas::Add(const char* _text, int _x, int _y, const SDL_Color& _colour)
+{
+  if (!IsCreated()) { return; }
+
+  int pen = _x;
+  for (const char* c = _text; *c != '\0'; ++c)
+  {
+    int i = static_cast<unsigned char>(*c) - First;
+    if (i < 0 || i > Last - First) { continue; }
+
+    const Glyph& glyph = m_glyphs[i];
+    if (glyph.region.w > 0)
+    {
+      m_quads.AddQuad(
+        glyph.region,
+        static_cast<float>(pen + glyph.offset), static_cast<float>(_y),
+        static_cast<float>(glyph.region.w), static_cast<float>(glyph.region.h),
+        _colour
+      );
+    }
+    pen += glyph.advance;
+  }
+}
+
+void GlyphAtlas::Flush(Renderer& _renderer)
+{
+  if (m_quads.Empty()) { return; }
+
+  //keep the batched primitives underneath the text.
+  _renderer.Flush();
+  m_quads.Flush(_renderer.Get(), m_atlas);
+}
+
+int GlyphAtlas::GetWidth(const char* _text) const
+{
+  int width = 0;
+  for (const char* c = _text; *c != '\0'; ++c)
+  {
+    int i = static_cast<unsigned char>(*c) - First;
+    if (i < 0 || i > Last - First) { continue; }
+    width += m_glyphs[i].advance;
+  }
+  return width;
+}
+
+int GlyphAtlas::GetHeight() const
+{
+  return m_height;
+}
@@ -0,0 +1,78 @@
+#ifndef _GLYPHATLAS_H_
+#define _GLYPHATLAS_H_
+
+#include "SDL.h"
+
+#include "Texture.h"
+#include "QuadBatch.h"
+
+class Font;
+class Renderer;
+
+/**
+ * \brief Draw text from glyphs rasterized once.
+ * Every printable ASCII character of a font is rendered into one
+ * texture when the atlas is created. Text is then a quad per
+ * character, collected in a QuadBatch, so changing the text
+ * does not create any textures.
+ */
+
+class GlyphAtlas
+{
+ public:
+  static const int First = 32;  //!< First character in the atlas (space).
+  static const int Last  = 126; //!< Last character in the atlas (~).
+
+  GlyphAtlas(); //!< Constructor.
+  ~GlyphAtlas(); //!< Destructor.
+
+  /**
+   * \brief Rasterize the glyphs of a font.
+   * \param [in] _renderer Renderer the atlas is used with.
+   * \param [in] _font     Font of the glyphs.
+   * \return Returns true if the atlas was successfully created.
+   */
+  bool Create(Renderer& _renderer, const Font& _font);
+
+  void Destroy(); //!< Free the atlas.
+
+  bool IsCreated() const; //!< Has the atlas been built?
+
+  /**
+   * \brief Add text to the batch.
+   * Characters not in the atlas are skipped.
+   * \param [in] _text   Text to write.
+   * \param [in] _x      Left of the text.
+   * \param [in] _y      Top of the text.
+   * \param [in] _colour Colour of the text.
+   */
+  void Add(const char* _text, int _x, int _y, const SDL_Color& _colour);
+
+  /**
+   * \brief Draw all the text added since the last flush.
+   * \param [in, out] _renderer Renderer to draw to.
+   */
+  void Flush(Renderer& _renderer);
+
+  int GetWidth(const char* _text) const; //!< Get the width of text in pixels.
+  int GetHeight() const; //!< Get the height of a line in pixels.
+
+ private:
+  /**
+   * \brief Position of a character in the atlas.
+   */
+  struct Glyph
+  {
+    SDL_Rect region; //!< Area of the atlas, empty for blank characters.
+    int offset; //!< Distance from the pen to the left of the region.
+    int advance; //!< Distance to move the pen after the character.
+  };
+
+  Texture m_atlas; //!< Every glyph in white.
+  Glyph m_glyphs[Last - First + 1]; //!< Glyph of each character.
+  int m_height; //!< Height of a line.
+
+  QuadBatch m_quads; //!< Characters to draw.
+};
+
+#endif //_GLYPHATLAS_H_
@@ -0,0 +1,184 @@
+#include "Islands.h"
+
+#include <limits>
+
+#include "Collider.h"
+#include "ColliderStore.h"
+
+Islands::Islands() :
+  m_enabled(true),
+  m_sleepSpeed(2.f),
+  m_sleepTime(.5f),
+  m_islandCount(0u),
+  m_sleepingCount(0u)
+{ }
+
+Islands::~Islands()
+{ }
+
+void Islands::Update(ColliderStore& _store, const std::vector<CollisionData>& _contacts, float _deltaTime)
+{
+  m_colliders.clear();
+
+  //only moving colliders are part of islands.
+  for (int type = 0; type <= static_cast<int>(ColliderType::PLANE); ++type)
+  {
+    for (auto collider : _store.GetPool(static_cast<ColliderType>(type)).objects)
+    {
+      if (collider->m_invMass != .0f)
+      {
+        collider->m_island = m_colliders.size();
+        m_colliders.push_back(collider);
+      }
+    }
+  }
+
+  size_t count = m_colliders.size();
+  m_parents.resize(count);
+  m_sizes.assign(count, 1u);
+  for (size_t i = 0; i < count; ++i)
+  {
+    m_parents[i] = i;
+  }
+
+  //join the colliders that touch.
+  for (auto& contact : _contacts)
+  {
+    if (contact.a->m_invMass != .0f && contact.b->m_invMass != .0f)
+    {
+      Union(contact.a->m_island, contact.b->m_island);
+    }
+  }
+
+  //time how long each awake collider has been resting.
+  float speedSq = m_sleepSpeed * m_sleepSpeed;
+  for (auto collider : m_colliders)
+  {
+    if (!collider->m_awake) { continue; }
+
+    if (collider->m_velocity.MagnitudeSq() < speedSq)
+    {
+      collider->m_sleepTime += _deltaTime;
+    }
+    else
+    {
+      collider->m_sleepTime = .0f;
+    }
+  }
+
+  //an island can sleep once its most recently moving collider can.
+  m_restTimes.assign(count, std::numeric_limits<float>::max());
+  m_awake.assign(count, 0u);
+  m_islandCount = 0u;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    size_t root = Find(i);
+
+    if (m_colliders[i]->m_awake)
+    {
+      m_restTimes[root] = Min(m_restTimes[root], m_colliders[i]->m_sleepTime);
+      m_islandCount += m_awake[root] == 0u;
+      m_awake[root] = 1u;
+    }
+  }
+
+  m_sleepingCount = 0u;
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    Collider* collider = m_colliders[i];
+    size_t root = Find(i);
+
+    if (!m_enabled)
+    {
+      if (!collider->m_awake) { collider->SetAwake(true); }
+      continue;
+    }
+
+    //an island with nothing awake is left asleep.
+    if (m_awake[root] != 0u)
+    {
+      if (m_restTimes[root] >= m_sleepTime)
+      {
+        collider->SetAwake(false);
+      }
+      //something awake touched the island, wake all of it.
+      else if (!collider->m_awake)
+      {
+        collider->SetAwake(true);
+      }
+    }
+
+    if (!collider->m_awake) { ++m_sleepingCount; }
+  }
+}
+
+void Islands::SetEnabled(bool _enabled)
+{
+  m_enabled = _enabled;
+}
+
+bool Islands::GetEnabled() const
+{
+  return m_enabled;
+}
+
+void Islands::SetSleepSpeed(float _speed)
+{
+  m_sleepSpeed = _speed;
+}
+
+float Islands::GetSleepSpeed() const
+{
+  return m_sleepSpeed;
+}
+
+void Islands::SetSleepTime(float _time)
+{
+  m_sleepTime = _time;
+}
+
+float Islands::GetSleepTime() const
+{
+  return m_sleepTime;
+}
+
+size_t Islands::GetIslandCount() const
+{
+  return m_islandCount;
+}
+
+size_t Islands::GetSleepingCount() const
+{
+  return m_sleepingCount;
+}
+
+size_t Islands::Find(size_t _index)
+{
+  //point every other node at its grandparent on the way up, to keep the trees flat.
+  while (m_parents[_index] != _index)
+  {
+    m_parents[_index] = m_parents[m_parents[_index]];
+    _index = m_parents[_index];
+  }
+  return _index;
+}
+
+void Islands::Union(size_t _a, size_t _b)
+{
+  size_t a = Find(_a);
+  size_t b = Find(_b);
+  if (a == b) { return; }
+
+  //hang the smaller tree under the larger.
+  if (m_sizes[a] < m_sizes[b])
+  {
+    size_t swap = a;
+    a = b;
+    b = swap;
+  }
+
+  m_parents[b] = a;
+  m_sizes[a] += m_sizes[b];
+}
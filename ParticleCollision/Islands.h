@@ -0,0 +1,81 @@
+#ifndef _ISLANDS_H_
+#define _ISLANDS_H_
+
+#include <vector>
+
+#include "CollisionData.h"
+
+class Collider;
+class ColliderStore;
+
+/**
+ * \brief Put groups of resting colliders to sleep.
+ * The colliders that touch each other, directly or through others,
+ * form an island. Islands are found each frame from the contacts with
+ * a union-find over the moving colliders; static colliders are left
+ * out so a floor does not join everything on it into one island.
+ * Once every collider in an island has been slower than the sleep
+ * speed for the sleep time, the whole island sleeps. Sleeping colliders
+ * are not integrated, their bounds are not refreshed and pairs of them
+ * are skipped by the narrow phase. An island wakes when an awake
+ * collider touches it or Collider::SetAwake is called.
+ */
+
+class Islands
+{
+ public:
+  Islands(); //!< Constructor.
+  ~Islands(); //!< Destructor.
+
+  /**
+   * \brief Find the islands and wake or sleep them.
+   * Call after the collisions have been resolved.
+   * \param [in, out] _store     Colliders to group.
+   * \param [in]      _contacts  Collisions of this frame.
+   * \param [in]      _deltaTime Time of the frame.
+   */
+  void Update(ColliderStore& _store, const std::vector<CollisionData>& _contacts, float _deltaTime);
+
+  void SetEnabled(bool _enabled); //!< Turn sleeping on or off, turning it off wakes everything on the next update.
+  bool GetEnabled() const; //!< Can colliders sleep?
+
+  void SetSleepSpeed(float _speed); //!< Set the speed below which a collider is resting.
+  float GetSleepSpeed() const; //!< Get the speed below which a collider is resting.
+
+  void SetSleepTime(float _time); //!< Set how long an island must rest before sleeping.
+  float GetSleepTime() const; //!< Get how long an island must rest before sleeping.
+
+  size_t GetIslandCount() const; //!< Get the number of awake islands found in the last update.
+  size_t GetSleepingCount() const; //!< Get the number of colliders asleep after the last update.
+
+ private:
+  /**
+   * \brief Find the root of a collider's island.
+   * \param [in] _index Index of the collider.
+   * \return Returns the index of the root.
+   */
+  size_t Find(size_t _index);
+
+  /**
+   * \brief Join the islands of two colliders.
+   * \param [in] _a Index of the first collider.
+   * \param [in] _b Index of the second collider.
+   */
+  void Union(size_t _a, size_t _b);
+
+  std::vector<Collider*> m_colliders; //!< Moving colliders, indexed by Collider::m_island.
+  std::vector<size_t> m_parents; //!< Parent of each collider in the union-find, a root is its own parent.
+  std::vector<size_t> m_sizes; //!< Number of colliders under each root.
+
+  std::vector<float> m_restTimes; //!< Shortest rest time in each island, by root.
+  std::vector<unsigned char> m_awake; //!< Does each island have an awake collider, by root.
+
+  bool m_enabled; //!< Can colliders sleep?
+  float m_sleepSpeed; //!< Speed below which a collider is resting.
+  float m_sleepTime; //!< Time an island must rest before sleeping.
+
+  size_t m_islandCount; //!< Awake islands found in the last update.
+  size_t m_sleepingCount; //!< Colliders asleep after the last update.
+};
+
+#endif //_ISLANDS_H_
@@ -0,0 +1,132 @@
+#include "Kernels.h"
+
+#include <cstring>
+
+#include "SDL_cpuinfo.h"
+
+#ifdef KERNELS_X86
+  #if defined(_MSC_VER)
+    #include <intrin.h>
+  #else
+    #include <cpuid.h>
+  #endif
+#endif
+
+const KernelTable* Kernels::s_table = nullptr;
+KernelLevel Kernels::s_level = KernelLevel::SCALAR;
+
+namespace
+{
+  const char* const s_names[] = { "scalar", "sse", "avx2", "avx512" }; //!< Name of each level.
+
+  /**
+   * \brief Check for AVX-512 Foundation.
+   * SDL does not report it, so cpuid is read directly. The OS also
+   * has to save the mask and the upper halves of the registers.
+   */
+  bool HasAVX512()
+  {
+#ifdef KERNELS_X86
+    unsigned int regs[4] = { 0u, 0u, 0u, 0u };
+
+  #if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) { return false; }
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    __cpuidex(info, 7, 0);
+    memcpy(regs, info, sizeof(regs));
+    if (!osxsave) { return false; }
+    unsigned long long xcr0 = _xgetbv(0);
+  #else
+    if (__get_cpuid_max(0, nullptr) < 7) { return false; }
+    __cpuid(1, regs[0], regs[1], regs[2], regs[3]);
+    if ((regs[2] & (1u << 27)) == 0u) { return false; }
+    __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+    unsigned int xcr0Low, xcr0High;
+    __asm__ __volatile__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    unsigned long long xcr0 = (static_cast<unsigned long long>(xcr0High) << 32) | xcr0Low;
+  #endif
+
+    //avx512f is bit 16 of ebx, xcr0 needs the sse, avx, mask and zmm state.
+    return (regs[1] & (1u << 16)) != 0u && (xcr0 & 0xE6u) == 0xE6u;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * \brief Find the best level the processor supports.
+   * \return Returns the level.
+   */
+  KernelLevel Detect()
+  {
+#ifdef KERNELS_X86
+    if (SDL_HasAVX2() && HasAVX512()) { return KernelLevel::AVX512; }
+    if (SDL_HasAVX2()) { return KernelLevel::AVX2; }
+    if (SDL_HasSSE2()) { return KernelLevel::SSE; }
+#endif
+    return KernelLevel::SCALAR;
+  }
+}
+
+const KernelTable& Kernels::Get()
+{
+  if (s_table == nullptr)
+  {
+    SetLevel(GetSupported());
+  }
+  return *s_table;
+}
+
+KernelLevel Kernels::GetLevel()
+{
+  Get();
+  return s_level;
+}
+
+KernelLevel Kernels::GetSupported()
+{
+  static KernelLevel supported = Detect();
+  return supported;
+}
+
+KernelLevel Kernels::SetLevel(KernelLevel _level)
+{
+  //never use an instruction set the processor does not have.
+  if (static_cast<int>(_level) > static_cast<int>(GetSupported()))
+  {
+    _level = GetSupported();
+  }
+
+  switch (_level)
+  {
+    case KernelLevel::AVX512: s_table = &GetAVX512Kernels(); break;
+    case KernelLevel::AVX2:   s_table = &GetAVX2Kernels();   break;
+    case KernelLevel::SSE:    s_table = &GetSSEKernels();    break;
+    default:                  s_table = &GetScalarKernels(); _level = KernelLevel::SCALAR; break;
+  }
+
+  s_level = _level;
+  return s_level;
+}
+
+const char* Kernels::GetName(KernelLevel _level)
+{
+  size_t index = static_cast<size_t>(_level);
+  return index < static_cast<size_t>(KernelLevel::COUNT) ? s_names[index] : "unknown";
+}
+
+bool Kernels::FromName(const char* _name, KernelLevel& _level)
+{
+  for (size_t i = 0; i < static_cast<size_t>(KernelLevel::COUNT); ++i)
+  {
+    if (strcmp(_name, s_names[i]) == 0)
+    {
+      _level = static_cast<KernelLevel>(i);
+      return true;
+    }
+  }
+  return false;
+}
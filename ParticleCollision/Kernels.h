@@ -0,0 +1,156 @@
+#ifndef _KERNELS_H_
+#define _KERNELS_H_
+
+#include <cstddef>
+
+#include "Maths.h"
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+  #define KERNELS_X86
+#endif
+
+//functions that use a wider instruction set than the rest of the build.
+#if defined(__GNUC__)
+  #define KERNELS_TARGET(_isa) __attribute__((target(_isa)))
+#else
+  #define KERNELS_TARGET(_isa)
+#endif
+
+class Rect;
+class Range;
+struct ColliderPool;
+
+enum class KernelLevel
+{
+  SCALAR,
+  SSE,
+  AVX2,
+  AVX512,
+  COUNT
+}; //!< Instruction sets the kernels can use.
+
+/**
+ * \brief Arrays of a batch of circle pairs.
+ * The arrays hold size pairs, a multiple of 8, with one hit mask
+ * for every 8 pairs.
+ */
+
+struct CircleLanes
+{
+  const float* ax; //!< X of the first circles.
+  const float* ay; //!< Y of the first circles.
+  const float* bx; //!< X of the second circles.
+  const float* by; //!< Y of the second circles.
+  const float* radius; //!< Radii of both circles added together.
+
+  float* overlap; //!< Depth of each pair.
+  float* nx; //!< Normal x of each pair, from b to a.
+  float* ny; //!< Normal y of each pair, from b to a.
+  unsigned int* hits; //!< Bit mask of the pairs that hit, one per 8 pairs.
+
+  size_t size; //!< Number of pairs.
+};
+
+/**
+ * \brief Arrays of the contacts and bodies of a velocity pass.
+ * Each contact refers to its two bodies by index. The velocities are
+ * gathered from the bodies and the changes scattered back to them, so
+ * the contacts of a pass must not share a moving body unless they are
+ * done one at a time. Static bodies, with an inverse mass of 0, can be
+ * shared as they are never written.
+ */
+
+struct ContactLanes
+{
+  float* vx; //!< X velocity of each body.
+  float* vy; //!< Y velocity of each body.
+  const float* invMass; //!< Inverse mass of each body.
+
+  const unsigned int* a; //!< First body of each contact.
+  const unsigned int* b; //!< Second body of each contact.
+  const float* nx; //!< Normal x of each contact, from b to a.
+  const float* ny; //!< Normal y of each contact, from b to a.
+  const float* mass; //!< Mass of each contact along the normal.
+  const float* target; //!< Separating speed each contact should reach.
+  float* impulse; //!< Total impulse of each contact, never negative.
+};
+
+/**
+ * \brief The kernels for one instruction set.
+ */
+
+struct KernelTable
+{
+  /**
+   * \brief Find the rects that overlap a rect.
+   * See Rect::Intersects.
+   */
+  size_t (*intersects)(const Rect& _rect, const Rect* _rects, size_t _count, size_t* _indices);
+
+  /**
+   * \brief Get the range of points on an axis.
+   * _count must be a multiple of 4.
+   */
+  Range (*project)(const float* _x, const float* _y, size_t _count, const Vector2& _axis);
+
+  void (*circles)(const CircleLanes& _lanes); //!< Check a batch of circle pairs.
+
+  void (*integrate)(ColliderPool& _pool, size_t _count, float _deltaTime); //!< Move the first _count colliders of a pool and their bounds.
+
+  /**
+   * \brief Solve the velocities of a range of contacts once.
+   * The scalar kernel does the contacts in order and allows shared
+   * bodies, the others need contacts that do not share a moving body.
+   */
+  void (*contacts)(const ContactLanes& _lanes, size_t _begin, size_t _end);
+};
+
+/**
+ * \brief Pick the kernels for the processor at run time.
+ * The best level the processor supports is used unless an override is
+ * set, so one build can use AVX2 or AVX-512 where it is there and fall
+ * back on older processors. Each level is in its own file so only
+ * those functions are built for the wider instruction sets.
+ */
+
+class Kernels
+{
+ public:
+  static const KernelTable& Get(); //!< Get the kernels in use.
+
+  static KernelLevel GetLevel(); //!< Get the level in use.
+  static KernelLevel GetSupported(); //!< Get the best level the processor and build support.
+
+  /**
+   * \brief Override the level, to compare the kernels.
+   * \param [in] _level Level to use, clamped to the supported level.
+   * \return Returns the level now in use.
+   */
+  static KernelLevel SetLevel(KernelLevel _level);
+
+  /**
+   * \brief Get the name of a level.
+   * \param [in] _level Level to name.
+   * \return Returns the name, such as "avx2".
+   */
+  static const char* GetName(KernelLevel _level);
+
+  /**
+   * \brief Get a level from its name.
+   * \param [in]  _name  Name of the level.
+   * \param [out] _level Set to the level if the name is known.
+   * \return Returns true if the name is known.
+   */
+  static bool FromName(const char* _name, KernelLevel& _level);
+
+ private:
+  static const KernelTable* s_table; //!< Kernels in use.
+  static KernelLevel s_level; //!< Level in use.
+};
+
+const KernelTable& GetScalarKernels(); //!< Kernels without SIMD.
+const KernelTable& GetSSEKernels(); //!< Kernels for SSE.
+const KernelTable& GetAVX2Kernels(); //!< Kernels for AVX2.
+const KernelTable& GetAVX512Kernels(); //!< Kernels for AVX-512.
+
+#endif //_KERNELS_H_
@@ -0,0 +1,230 @@
+#include "Kernels.h"
+
+#ifdef KERNELS_X86
+
+#include <limits>
+#include <immintrin.h>
+
+#include "Rect.h"
+#include "Range.h"
+#include "ColliderStore.h"
+
+namespace
+{
+  KERNELS_TARGET("avx2")
+  size_t Intersects(const Rect& _rect, const Rect* _rects, size_t _count, size_t* _indices)
+  {
+    //the same sign flip as the SSE kernel, with two rects per register.
+    const __m256 sign = _mm256_set_ps(-.0f, -.0f, .0f, .0f, -.0f, -.0f, .0f, .0f);
+    const __m256 bounds = _mm256_set_ps(
+      -_rect.min.y, -_rect.min.x, _rect.max.y, _rect.max.x,
+      -_rect.min.y, -_rect.min.x, _rect.max.y, _rect.max.x
+    );
+
+    size_t hits = 0u;
+    size_t i = 0u;
+    for (; i + 2u <= _count; i += 2u)
+    {
+      __m256 rects = _mm256_xor_ps(_mm256_loadu_ps(&_rects[i].min.x), sign);
+      int mask = _mm256_movemask_ps(_mm256_cmp_ps(rects, bounds, _CMP_LE_OQ));
+
+      _indices[hits] = i;
+      hits += (mask & 0xF) == 0xF;
+      _indices[hits] = i + 1u;
+      hits += (mask >> 4) == 0xF;
+    }
+
+    if (i < _count)
+    {
+      _indices[hits] = i;
+      hits += Rect::Intersects(_rect, _rects[i]);
+    }
+    return hits;
+  }
+
+  KERNELS_TARGET("avx2")
+  Range Project(const float* _x, const float* _y, size_t _count, const Vector2& _axis)
+  {
+    __m256 ax = _mm256_set1_ps(_axis.x);
+    __m256 ay = _mm256_set1_ps(_axis.y);
+
+    __m256 min = _mm256_set1_ps(std::numeric_limits<float>::max());
+    __m256 max = _mm256_set1_ps(-std::numeric_limits<float>::max());
+
+    size_t i = 0u;
+    for (; i + 8u <= _count; i += 8u)
+    {
+      __m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(_x + i), ax), _mm256_mul_ps(_mm256_loadu_ps(_y + i), ay));
+      min = _mm256_min_ps(min, d);
+      max = _mm256_max_ps(max, d);
+    }
+
+    //fold into four lanes, the count is a multiple of four so there is at most one group left.
+    __m128 min4 = _mm_min_ps(_mm256_castps256_ps128(min), _mm256_extractf128_ps(min, 1));
+    __m128 max4 = _mm_max_ps(_mm256_castps256_ps128(max), _mm256_extractf128_ps(max, 1));
+
+    if (i < _count)
+    {
+      __m128 d = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_x + i), _mm256_castps256_ps128(ax)), _mm_mul_ps(_mm_loadu_ps(_y + i), _mm256_castps256_ps128(ay)));
+      min4 = _mm_min_ps(min4, d);
+      max4 = _mm_max_ps(max4, d);
+    }
+
+    min4 = _mm_min_ps(min4, _mm_shuffle_ps(min4, min4, _MM_SHUFFLE(1, 0, 3, 2)));
+    min4 = _mm_min_ps(min4, _mm_shuffle_ps(min4, min4, _MM_SHUFFLE(2, 3, 0, 1)));
+    max4 = _mm_max_ps(max4, _mm_shuffle_ps(max4, max4, _MM_SHUFFLE(1, 0, 3, 2)));
+    max4 = _mm_max_ps(max4, _mm_shuffle_ps(max4, max4, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return Range(_mm_cvtss_f32(min4), _mm_cvtss_f32(max4));
+  }
+
+  KERNELS_TARGET("avx2")
+  void Circles(const CircleLanes& _lanes)
+  {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.f);
+
+    for (size_t i = 0; i < _lanes.size; i += 8u)
+    {
+      __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(_lanes.ax + i), _mm256_loadu_ps(_lanes.bx + i));
+      __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(_lanes.ay + i), _mm256_loadu_ps(_lanes.by + i));
+      __m256 rad = _mm256_loadu_ps(_lanes.radius + i);
+
+      __m256 distSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+      __m256 hit = _mm256_cmp_ps(distSq, _mm256_mul_ps(rad, rad), _CMP_LE_OQ);
+
+      //circles on top of each other are pushed apart on y.
+      __m256 same = _mm256_cmp_ps(distSq, zero, _CMP_EQ_OQ);
+      dy = _mm256_blendv_ps(dy, one, same);
+      __m256 dist = _mm256_sqrt_ps(_mm256_blendv_ps(distSq, one, same));
+      __m256 inv = _mm256_div_ps(one, dist);
+
+      _mm256_storeu_ps(_lanes.overlap + i, _mm256_max_ps(_mm256_sub_ps(rad, _mm256_blendv_ps(dist, zero, same)), zero));
+      _mm256_storeu_ps(_lanes.nx + i, _mm256_mul_ps(dx, inv));
+      _mm256_storeu_ps(_lanes.ny + i, _mm256_mul_ps(dy, inv));
+      _lanes.hits[i / 8u] = static_cast<unsigned int>(_mm256_movemask_ps(hit));
+    }
+  }
+
+  KERNELS_TARGET("avx2")
+  void Integrate(ColliderPool& _pool, size_t _count, float _deltaTime)
+  {
+    size_t i = 0u;
+
+    float* x = _pool.x.data();
+    float* y = _pool.y.data();
+    const float* vx = _pool.vx.data();
+    const float* vy = _pool.vy.data();
+
+    //eight colliders at a time.
+    __m256 dt = _mm256_set1_ps(_deltaTime);
+
+    for (; i + 8u <= _count; i += 8u)
+    {
+      __m256 px = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), dt));
+      __m256 py = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), dt));
+      _mm256_storeu_ps(x + i, px);
+      _mm256_storeu_ps(y + i, py);
+
+      _mm256_storeu_ps(&_pool.minX[i], _mm256_add_ps(px, _mm256_loadu_ps(&_pool.localMinX[i])));
+      _mm256_storeu_ps(&_pool.minY[i], _mm256_add_ps(py, _mm256_loadu_ps(&_pool.localMinY[i])));
+      _mm256_storeu_ps(&_pool.maxX[i], _mm256_add_ps(px, _mm256_loadu_ps(&_pool.localMaxX[i])));
+      _mm256_storeu_ps(&_pool.maxY[i], _mm256_add_ps(py, _mm256_loadu_ps(&_pool.localMaxY[i])));
+    }
+
+    //the colliders that did not fill a group.
+    for (; i < _count; ++i)
+    {
+      x[i] += vx[i] * _deltaTime;
+      y[i] += vy[i] * _deltaTime;
+
+      _pool.minX[i] = x[i] + _pool.localMinX[i];
+      _pool.minY[i] = y[i] + _pool.localMinY[i];
+      _pool.maxX[i] = x[i] + _pool.localMaxX[i];
+      _pool.maxY[i] = y[i] + _pool.localMaxY[i];
+    }
+  }
+
+  /**
+   * \brief Store the velocities of eight bodies, skipping static ones.
+   * AVX2 has no scatter, so the lanes are stored one at a time.
+   * \param [in] _lanes   Arrays of the bodies.
+   * \param [in] _indices Bodies to store.
+   * \param [in] _vx      New x velocities.
+   * \param [in] _vy      New y velocities.
+   */
+  KERNELS_TARGET("avx2")
+  inline void Scatter(const ContactLanes& _lanes, const unsigned int* _indices, __m256 _vx, __m256 _vy)
+  {
+    alignas(32) float vx[8];
+    alignas(32) float vy[8];
+    _mm256_store_ps(vx, _vx);
+    _mm256_store_ps(vy, _vy);
+
+    for (size_t lane = 0; lane < 8u; ++lane)
+    {
+      unsigned int body = _indices[lane];
+      if (_lanes.invMass[body] != .0f)
+      {
+        _lanes.vx[body] = vx[lane];
+        _lanes.vy[body] = vy[lane];
+      }
+    }
+  }
+
+  KERNELS_TARGET("avx2")
+  void Contacts(const ContactLanes& _lanes, size_t _begin, size_t _end)
+  {
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t i = _begin;
+
+    //eight contacts at a time, they do not share a moving body so the lanes are independent.
+    for (; i + 8u <= _end; i += 8u)
+    {
+      __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_lanes.a + i));
+      __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(_lanes.b + i));
+
+      __m256 vax = _mm256_i32gather_ps(_lanes.vx, a, 4);
+      __m256 vay = _mm256_i32gather_ps(_lanes.vy, a, 4);
+      __m256 vbx = _mm256_i32gather_ps(_lanes.vx, b, 4);
+      __m256 vby = _mm256_i32gather_ps(_lanes.vy, b, 4);
+      __m256 nx = _mm256_loadu_ps(_lanes.nx + i);
+      __m256 ny = _mm256_loadu_ps(_lanes.ny + i);
+
+      __m256 speed = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(vax, vbx), nx), _mm256_mul_ps(_mm256_sub_ps(vay, vby), ny));
+      __m256 lambda = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(_lanes.target + i), speed), _mm256_loadu_ps(_lanes.mass + i));
+
+      __m256 impulse = _mm256_loadu_ps(_lanes.impulse + i);
+      __m256 total = _mm256_max_ps(_mm256_add_ps(impulse, lambda), zero);
+      lambda = _mm256_sub_ps(total, impulse);
+      _mm256_storeu_ps(_lanes.impulse + i, total);
+
+      __m256 ix = _mm256_mul_ps(nx, lambda);
+      __m256 iy = _mm256_mul_ps(ny, lambda);
+      __m256 ma = _mm256_i32gather_ps(_lanes.invMass, a, 4);
+      __m256 mb = _mm256_i32gather_ps(_lanes.invMass, b, 4);
+
+      Scatter(_lanes, _lanes.a + i, _mm256_add_ps(vax, _mm256_mul_ps(ix, ma)), _mm256_add_ps(vay, _mm256_mul_ps(iy, ma)));
+      Scatter(_lanes, _lanes.b + i, _mm256_sub_ps(vbx, _mm256_mul_ps(ix, mb)), _mm256_sub_ps(vby, _mm256_mul_ps(iy, mb)));
+    }
+
+    //the contacts that did not fill a group.
+    GetScalarKernels().contacts(_lanes, i, _end);
+  }
+}
+
+const KernelTable& GetAVX2Kernels()
+{
+  static const KernelTable table = { &Intersects, &Project, &Circles, &Integrate, &Contacts };
+  return table;
+}
+
+#else
+
+const KernelTable& GetAVX2Kernels()
+{
+  return GetScalarKernels();
+}
+
+#endif
@@ -0,0 +1,196 @@
+#include "Kernels.h"
+
+#ifdef KERNELS_X86
+
+#include <limits>
+#include <immintrin.h>
+
+#include "Rect.h"
+#include "Range.h"
+#include "ColliderStore.h"
+
+namespace
+{
+  /**
+   * \brief Get the mask of the lanes left to do.
+   * \param [in] _left Number of values left.
+   * \return Returns all 16 lanes, or the first _left.
+   */
+  inline __mmask16 LaneMask(size_t _left)
+  {
+    return static_cast<__mmask16>(_left >= 16u ? 0xFFFFu : (1u << _left) - 1u);
+  }
+
+  KERNELS_TARGET("avx512f")
+  size_t Intersects(const Rect& _rect, const Rect* _rects, size_t _count, size_t* _indices)
+  {
+    //the same sign flip as the SSE kernel, with four rects per register.
+    const __m512 sign = _mm512_castsi512_ps(_mm512_set4_epi32(
+      static_cast<int>(0x80000000u), static_cast<int>(0x80000000u), 0, 0));
+    const __m512 bounds = _mm512_set4_ps(-_rect.min.y, -_rect.min.x, _rect.max.y, _rect.max.x);
+
+    size_t hits = 0u;
+    for (size_t i = 0; i < _count; i += 4u)
+    {
+      size_t left = _count - i < 4u ? _count - i : 4u;
+      __mmask16 lanes = LaneMask(left * 4u);
+
+      __m512 rects = _mm512_maskz_loadu_ps(lanes, &_rects[i].min.x);
+      rects = _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(rects), _mm512_castps_si512(sign)));
+      unsigned int mask = _mm512_mask_cmp_ps_mask(lanes, rects, bounds, _CMP_LE_OQ);
+
+      for (size_t j = 0; j < left; ++j)
+      {
+        _indices[hits] = i + j;
+        hits += ((mask >> (j * 4u)) & 0xFu) == 0xFu;
+      }
+    }
+    return hits;
+  }
+
+  KERNELS_TARGET("avx512f")
+  Range Project(const float* _x, const float* _y, size_t _count, const Vector2& _axis)
+  {
+    __m512 ax = _mm512_set1_ps(_axis.x);
+    __m512 ay = _mm512_set1_ps(_axis.y);
+
+    __m512 min = _mm512_set1_ps(std::numeric_limits<float>::max());
+    __m512 max = _mm512_set1_ps(-std::numeric_limits<float>::max());
+
+    for (size_t i = 0; i < _count; i += 16u)
+    {
+      //lanes past the end keep their old min and max.
+      __mmask16 lanes = LaneMask(_count - i);
+      __m512 d = _mm512_add_ps(
+        _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, _x + i), ax),
+        _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, _y + i), ay));
+      min = _mm512_mask_min_ps(min, lanes, min, d);
+      max = _mm512_mask_max_ps(max, lanes, max, d);
+    }
+
+    return Range(_mm512_reduce_min_ps(min), _mm512_reduce_max_ps(max));
+  }
+
+  KERNELS_TARGET("avx512f")
+  void Circles(const CircleLanes& _lanes)
+  {
+    const __m512 zero = _mm512_setzero_ps();
+    const __m512 one = _mm512_set1_ps(1.f);
+
+    //two groups at a time, the size is a multiple of 8 so the last may be one.
+    for (size_t i = 0; i < _lanes.size; i += 16u)
+    {
+      __mmask16 lanes = LaneMask(_lanes.size - i);
+
+      __m512 dx = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, _lanes.ax + i), _mm512_maskz_loadu_ps(lanes, _lanes.bx + i));
+      __m512 dy = _mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, _lanes.ay + i), _mm512_maskz_loadu_ps(lanes, _lanes.by + i));
+      __m512 rad = _mm512_maskz_loadu_ps(lanes, _lanes.radius + i);
+
+      __m512 distSq = _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy));
+      __mmask16 hit = _mm512_cmp_ps_mask(distSq, _mm512_mul_ps(rad, rad), _CMP_LE_OQ);
+
+      //circles on top of each other are pushed apart on y.
+      __mmask16 same = _mm512_cmp_ps_mask(distSq, zero, _CMP_EQ_OQ);
+      dy = _mm512_mask_blend_ps(same, dy, one);
+      __m512 dist = _mm512_sqrt_ps(_mm512_mask_blend_ps(same, distSq, one));
+      __m512 inv = _mm512_div_ps(one, dist);
+
+      _mm512_mask_storeu_ps(_lanes.overlap + i, lanes, _mm512_max_ps(_mm512_sub_ps(rad, _mm512_mask_blend_ps(same, dist, zero)), zero));
+      _mm512_mask_storeu_ps(_lanes.nx + i, lanes, _mm512_mul_ps(dx, inv));
+      _mm512_mask_storeu_ps(_lanes.ny + i, lanes, _mm512_mul_ps(dy, inv));
+
+      _lanes.hits[i / 8u] = hit & 0xFFu;
+      if (i + 8u < _lanes.size)
+      {
+        _lanes.hits[i / 8u + 1u] = (hit >> 8u) & 0xFFu;
+      }
+    }
+  }
+
+  KERNELS_TARGET("avx512f")
+  void Integrate(ColliderPool& _pool, size_t _count, float _deltaTime)
+  {
+    float* x = _pool.x.data();
+    float* y = _pool.y.data();
+    const float* vx = _pool.vx.data();
+    const float* vy = _pool.vy.data();
+
+    //sixteen colliders at a time, the last group is masked.
+    __m512 dt = _mm512_set1_ps(_deltaTime);
+
+    for (size_t i = 0; i < _count; i += 16u)
+    {
+      __mmask16 lanes = LaneMask(_count - i);
+
+      __m512 px = _mm512_add_ps(_mm512_maskz_loadu_ps(lanes, x + i), _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, vx + i), dt));
+      __m512 py = _mm512_add_ps(_mm512_maskz_loadu_ps(lanes, y + i), _mm512_mul_ps(_mm512_maskz_loadu_ps(lanes, vy + i), dt));
+      _mm512_mask_storeu_ps(x + i, lanes, px);
+      _mm512_mask_storeu_ps(y + i, lanes, py);
+
+      _mm512_mask_storeu_ps(&_pool.minX[i], lanes, _mm512_add_ps(px, _mm512_maskz_loadu_ps(lanes, &_pool.localMinX[i])));
+      _mm512_mask_storeu_ps(&_pool.minY[i], lanes, _mm512_add_ps(py, _mm512_maskz_loadu_ps(lanes, &_pool.localMinY[i])));
+      _mm512_mask_storeu_ps(&_pool.maxX[i], lanes, _mm512_add_ps(px, _mm512_maskz_loadu_ps(lanes, &_pool.localMaxX[i])));
+      _mm512_mask_storeu_ps(&_pool.maxY[i], lanes, _mm512_add_ps(py, _mm512_maskz_loadu_ps(lanes, &_pool.localMaxY[i])));
+    }
+  }
+
+  KERNELS_TARGET("avx512f")
+  void Contacts(const ContactLanes& _lanes, size_t _begin, size_t _end)
+  {
+    const __m512 zero = _mm512_setzero_ps();
+
+    //sixteen contacts at a time, the last group is masked.
+    //they do not share a moving body, so the scatters never collide.
+    for (size_t i = _begin; i < _end; i += 16u)
+    {
+      __mmask16 lanes = LaneMask(_end - i);
+
+      __m512i a = _mm512_maskz_loadu_epi32(lanes, _lanes.a + i);
+      __m512i b = _mm512_maskz_loadu_epi32(lanes, _lanes.b + i);
+
+      __m512 vax = _mm512_mask_i32gather_ps(zero, lanes, a, _lanes.vx, 4);
+      __m512 vay = _mm512_mask_i32gather_ps(zero, lanes, a, _lanes.vy, 4);
+      __m512 vbx = _mm512_mask_i32gather_ps(zero, lanes, b, _lanes.vx, 4);
+      __m512 vby = _mm512_mask_i32gather_ps(zero, lanes, b, _lanes.vy, 4);
+      __m512 nx = _mm512_maskz_loadu_ps(lanes, _lanes.nx + i);
+      __m512 ny = _mm512_maskz_loadu_ps(lanes, _lanes.ny + i);
+
+      __m512 speed = _mm512_add_ps(_mm512_mul_ps(_mm512_sub_ps(vax, vbx), nx), _mm512_mul_ps(_mm512_sub_ps(vay, vby), ny));
+      __m512 lambda = _mm512_mul_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(lanes, _lanes.target + i), speed), _mm512_maskz_loadu_ps(lanes, _lanes.mass + i));
+
+      __m512 impulse = _mm512_maskz_loadu_ps(lanes, _lanes.impulse + i);
+      __m512 total = _mm512_max_ps(_mm512_add_ps(impulse, lambda), zero);
+      lambda = _mm512_sub_ps(total, impulse);
+      _mm512_mask_storeu_ps(_lanes.impulse + i, lanes, total);
+
+      __m512 ix = _mm512_mul_ps(nx, lambda);
+      __m512 iy = _mm512_mul_ps(ny, lambda);
+      __m512 ma = _mm512_mask_i32gather_ps(zero, lanes, a, _lanes.invMass, 4);
+      __m512 mb = _mm512_mask_i32gather_ps(zero, lanes, b, _lanes.invMass, 4);
+
+      //static bodies are not written.
+      __mmask16 movingA = _mm512_mask_cmp_ps_mask(lanes, ma, zero, _CMP_NEQ_OQ);
+      __mmask16 movingB = _mm512_mask_cmp_ps_mask(lanes, mb, zero, _CMP_NEQ_OQ);
+
+      _mm512_mask_i32scatter_ps(_lanes.vx, movingA, a, _mm512_add_ps(vax, _mm512_mul_ps(ix, ma)), 4);
+      _mm512_mask_i32scatter_ps(_lanes.vy, movingA, a, _mm512_add_ps(vay, _mm512_mul_ps(iy, ma)), 4);
+      _mm512_mask_i32scatter_ps(_lanes.vx, movingB, b, _mm512_sub_ps(vbx, _mm512_mul_ps(ix, mb)), 4);
+      _mm512_mask_i32scatter_ps(_lanes.vy, movingB, b, _mm512_sub_ps(vby, _mm512_mul_ps(iy, mb)), 4);
+    }
+  }
+}
+
+const KernelTable& GetAVX512Kernels()
+{
+  static const KernelTable table = { &Intersects, &Project, &Circles, &Integrate, &Contacts };
+  return table;
+}
+
+#else
+
+const KernelTable& GetAVX512Kernels()
+{
+  return GetScalarKernels();
+}
+
+#endif
@@ -0,0 +1,220 @@
+#include "Kernels.h"
+
+#ifdef KERNELS_X86
+
+#include <limits>
+#include <xmmintrin.h>
+
+#include "Rect.h"
+#include "Range.h"
+#include "ColliderStore.h"
+
+namespace
+{
+  size_t Intersects(const Rect& _rect, const Rect* _rects, size_t _count, size_t* _indices)
+  {
+    //a.min <= b.max and -a.max <= -b.min, so flipping the sign of the
+    //max half lets one compare test all four sides.
+    const __m128 sign = _mm_set_ps(-.0f, -.0f, .0f, .0f);
+    const __m128 bounds = _mm_set_ps(-_rect.min.y, -_rect.min.x, _rect.max.y, _rect.max.x);
+
+    size_t hits = 0u;
+    for (size_t i = 0; i < _count; ++i)
+    {
+      __m128 rect = _mm_xor_ps(_mm_loadu_ps(&_rects[i].min.x), sign);
+      _indices[hits] = i;
+      hits += _mm_movemask_ps(_mm_cmple_ps(rect, bounds)) == 0xF;
+    }
+    return hits;
+  }
+
+  Range Project(const float* _x, const float* _y, size_t _count, const Vector2& _axis)
+  {
+    __m128 ax = _mm_set1_ps(_axis.x);
+    __m128 ay = _mm_set1_ps(_axis.y);
+
+    __m128 min = _mm_set1_ps(std::numeric_limits<float>::max());
+    __m128 max = _mm_set1_ps(-std::numeric_limits<float>::max());
+
+    for (size_t i = 0; i < _count; i += 4u)
+    {
+      __m128 d = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_x + i), ax), _mm_mul_ps(_mm_loadu_ps(_y + i), ay));
+      min = _mm_min_ps(min, d);
+      max = _mm_max_ps(max, d);
+    }
+
+    //reduce the four lanes.
+    min = _mm_min_ps(min, _mm_shuffle_ps(min, min, _MM_SHUFFLE(1, 0, 3, 2)));
+    min = _mm_min_ps(min, _mm_shuffle_ps(min, min, _MM_SHUFFLE(2, 3, 0, 1)));
+    max = _mm_max_ps(max, _mm_shuffle_ps(max, max, _MM_SHUFFLE(1, 0, 3, 2)));
+    max = _mm_max_ps(max, _mm_shuffle_ps(max, max, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    return Range(_mm_cvtss_f32(min), _mm_cvtss_f32(max));
+  }
+
+  void Circles(const CircleLanes& _lanes)
+  {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+
+    //each group of 8 is done as two halves.
+    for (size_t i = 0; i < _lanes.size; i += 4u)
+    {
+      __m128 dx = _mm_sub_ps(_mm_loadu_ps(_lanes.ax + i), _mm_loadu_ps(_lanes.bx + i));
+      __m128 dy = _mm_sub_ps(_mm_loadu_ps(_lanes.ay + i), _mm_loadu_ps(_lanes.by + i));
+      __m128 rad = _mm_loadu_ps(_lanes.radius + i);
+
+      __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+      __m128 hit = _mm_cmple_ps(distSq, _mm_mul_ps(rad, rad));
+
+      //circles on top of each other are pushed apart on y.
+      __m128 same = _mm_cmpeq_ps(distSq, zero);
+      dy = _mm_or_ps(_mm_andnot_ps(same, dy), _mm_and_ps(same, one));
+      __m128 dist = _mm_sqrt_ps(_mm_or_ps(_mm_andnot_ps(same, distSq), _mm_and_ps(same, one)));
+      __m128 inv = _mm_div_ps(one, dist);
+
+      _mm_storeu_ps(_lanes.overlap + i, _mm_max_ps(_mm_sub_ps(rad, _mm_andnot_ps(same, dist)), zero));
+      _mm_storeu_ps(_lanes.nx + i, _mm_mul_ps(dx, inv));
+      _mm_storeu_ps(_lanes.ny + i, _mm_mul_ps(dy, inv));
+
+      unsigned int mask = static_cast<unsigned int>(_mm_movemask_ps(hit));
+      if (i % 8u == 0u)
+      {
+        _lanes.hits[i / 8u] = mask;
+      }
+      else
+      {
+        _lanes.hits[i / 8u] |= mask << 4u;
+      }
+    }
+  }
+
+  void Integrate(ColliderPool& _pool, size_t _count, float _deltaTime)
+  {
+    size_t i = 0u;
+
+    float* x = _pool.x.data();
+    float* y = _pool.y.data();
+    const float* vx = _pool.vx.data();
+    const float* vy = _pool.vy.data();
+
+    //four colliders at a time.
+    __m128 dt = _mm_set1_ps(_deltaTime);
+
+    for (; i + 4u <= _count; i += 4u)
+    {
+      __m128 px = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), dt));
+      __m128 py = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), dt));
+      _mm_storeu_ps(x + i, px);
+      _mm_storeu_ps(y + i, py);
+
+      _mm_storeu_ps(&_pool.minX[i], _mm_add_ps(px, _mm_loadu_ps(&_pool.localMinX[i])));
+      _mm_storeu_ps(&_pool.minY[i], _mm_add_ps(py, _mm_loadu_ps(&_pool.localMinY[i])));
+      _mm_storeu_ps(&_pool.maxX[i], _mm_add_ps(px, _mm_loadu_ps(&_pool.localMaxX[i])));
+      _mm_storeu_ps(&_pool.maxY[i], _mm_add_ps(py, _mm_loadu_ps(&_pool.localMaxY[i])));
+    }
+
+    //the colliders that did not fill a group.
+    for (; i < _count; ++i)
+    {
+      x[i] += vx[i] * _deltaTime;
+      y[i] += vy[i] * _deltaTime;
+
+      _pool.minX[i] = x[i] + _pool.localMinX[i];
+      _pool.minY[i] = y[i] + _pool.localMinY[i];
+      _pool.maxX[i] = x[i] + _pool.localMaxX[i];
+      _pool.maxY[i] = y[i] + _pool.localMaxY[i];
+    }
+  }
+
+  /**
+   * \brief Load a value of four bodies.
+   * \param [in] _values  Value of each body.
+   * \param [in] _indices Bodies to load.
+   * \return Returns the values, the first body in the lowest lane.
+   */
+  inline __m128 Gather(const float* _values, const unsigned int* _indices)
+  {
+    return _mm_set_ps(_values[_indices[3]], _values[_indices[2]], _values[_indices[1]], _values[_indices[0]]);
+  }
+
+  /**
+   * \brief Store the velocities of four bodies, skipping static ones.
+   * \param [in] _lanes   Arrays of the bodies.
+   * \param [in] _indices Bodies to store.
+   * \param [in] _vx      New x velocities.
+   * \param [in] _vy      New y velocities.
+   */
+  inline void Scatter(const ContactLanes& _lanes, const unsigned int* _indices, __m128 _vx, __m128 _vy)
+  {
+    alignas(16) float vx[4];
+    alignas(16) float vy[4];
+    _mm_store_ps(vx, _vx);
+    _mm_store_ps(vy, _vy);
+
+    for (size_t lane = 0; lane < 4u; ++lane)
+    {
+      unsigned int body = _indices[lane];
+      if (_lanes.invMass[body] != .0f)
+      {
+        _lanes.vx[body] = vx[lane];
+        _lanes.vy[body] = vy[lane];
+      }
+    }
+  }
+
+  void Contacts(const ContactLanes& _lanes, size_t _begin, size_t _end)
+  {
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t i = _begin;
+
+    //four contacts at a time, they do not share a moving body so the lanes are independent.
+    for (; i + 4u <= _end; i += 4u)
+    {
+      const unsigned int* a = _lanes.a + i;
+      const unsigned int* b = _lanes.b + i;
+
+      __m128 vax = Gather(_lanes.vx, a);
+      __m128 vay = Gather(_lanes.vy, a);
+      __m128 vbx = Gather(_lanes.vx, b);
+      __m128 vby = Gather(_lanes.vy, b);
+      __m128 nx = _mm_loadu_ps(_lanes.nx + i);
+      __m128 ny = _mm_loadu_ps(_lanes.ny + i);
+
+      __m128 speed = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(vax, vbx), nx), _mm_mul_ps(_mm_sub_ps(vay, vby), ny));
+      __m128 lambda = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(_lanes.target + i), speed), _mm_loadu_ps(_lanes.mass + i));
+
+      __m128 impulse = _mm_loadu_ps(_lanes.impulse + i);
+      __m128 total = _mm_max_ps(_mm_add_ps(impulse, lambda), zero);
+      lambda = _mm_sub_ps(total, impulse);
+      _mm_storeu_ps(_lanes.impulse + i, total);
+
+      __m128 ix = _mm_mul_ps(nx, lambda);
+      __m128 iy = _mm_mul_ps(ny, lambda);
+      __m128 ma = Gather(_lanes.invMass, a);
+      __m128 mb = Gather(_lanes.invMass, b);
+
+      Scatter(_lanes, a, _mm_add_ps(vax, _mm_mul_ps(ix, ma)), _mm_add_ps(vay, _mm_mul_ps(iy, ma)));
+      Scatter(_lanes, b, _mm_sub_ps(vbx, _mm_mul_ps(ix, mb)), _mm_sub_ps(vby, _mm_mul_ps(iy, mb)));
+    }
+
+    //the contacts that did not fill a group.
+    GetScalarKernels().contacts(_lanes, i, _end);
+  }
+}
+
+const KernelTable& GetSSEKernels()
+{
+  static const KernelTable table = { &Intersects, &Project, &Circles, &Integrate, &Contacts };
+  return table;
+}
+
+#else
+
+const KernelTable& GetSSEKernels()
+{
+  return GetScalarKernels();
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include "Kernels.h"
+
+#include "Rect.h"
+#include "Range.h"
+#include "ColliderStore.h"
+
+namespace
+{
+  size_t Intersects(const Rect& _rect, const Rect* _rects, size_t _count, size_t* _indices)
+  {
+    size_t hits = 0u;
+    for (size_t i = 0; i < _count; ++i)
+    {
+      _indices[hits] = i;
+      hits += Rect::Intersects(_rect, _rects[i]);
+    }
+    return hits;
+  }
+
+  Range Project(const float* _x, const float* _y, size_t _count, const Vector2& _axis)
+  {
+    float d = _x[0] * _axis.x + _y[0] * _axis.y;
+    Range range(d, d);
+
+    for (size_t i = 1; i < _count; ++i)
+    {
+      d = _x[i] * _axis.x + _y[i] * _axis.y;
+      range.min = Min(d, range.min);
+      range.max = Max(d, range.max);
+    }
+    return range;
+  }
+
+  void Circles(const CircleLanes& _lanes)
+  {
+    for (size_t i = 0; i < _lanes.size; ++i)
+    {
+      float dx = _lanes.ax[i] - _lanes.bx[i];
+      float dy = _lanes.ay[i] - _lanes.by[i];
+      float rad = _lanes.radius[i];
+      float distSq = dx * dx + dy * dy;
+
+      //circles on top of each other are pushed apart on y.
+      if (distSq == .0f) { dy = 1.f; }
+      float dist = distSq == .0f ? 1.f : std::sqrt(distSq);
+      float inv = 1.f / dist;
+
+      _lanes.overlap[i] = Max(rad - (distSq == .0f ? .0f : dist), .0f);
+      _lanes.nx[i] = dx * inv;
+      _lanes.ny[i] = dy * inv;
+
+      if (i % 8u == 0u) { _lanes.hits[i / 8u] = 0u; }
+      if (distSq <= rad * rad)
+      {
+        _lanes.hits[i / 8u] |= 1u << (i % 8u);
+      }
+    }
+  }
+
+  void Integrate(ColliderPool& _pool, size_t _count, float _deltaTime)
+  {
+    for (size_t i = 0; i < _count; ++i)
+    {
+      _pool.x[i] += _pool.vx[i] * _deltaTime;
+      _pool.y[i] += _pool.vy[i] * _deltaTime;
+
+      _pool.minX[i] = _pool.x[i] + _pool.localMinX[i];
+      _pool.minY[i] = _pool.y[i] + _pool.localMinY[i];
+      _pool.maxX[i] = _pool.x[i] + _pool.localMaxX[i];
+      _pool.maxY[i] = _pool.y[i] + _pool.localMaxY[i];
+    }
+  }
+
+  void Contacts(const ContactLanes& _lanes, size_t _begin, size_t _end)
+  {
+    for (size_t i = _begin; i < _end; ++i)
+    {
+      unsigned int a = _lanes.a[i];
+      unsigned int b = _lanes.b[i];
+
+      //impulse to reach the target speed along the normal.
+      float speed = (_lanes.vx[a] - _lanes.vx[b]) * _lanes.nx[i] + (_lanes.vy[a] - _lanes.vy[b]) * _lanes.ny[i];
+      float lambda = (_lanes.target[i] - speed) * _lanes.mass[i];
+
+      //clamp the total, not the change, so an earlier push can be taken back.
+      float total = Max(_lanes.impulse[i] + lambda, .0f);
+      lambda = total - _lanes.impulse[i];
+      _lanes.impulse[i] = total;
+
+      //static bodies can be shared between threads, so only write the moving ones.
+      float ix = _lanes.nx[i] * lambda;
+      float iy = _lanes.ny[i] * lambda;
+      if (_lanes.invMass[a] != .0f)
+      {
+        _lanes.vx[a] += ix * _lanes.invMass[a];
+        _lanes.vy[a] += iy * _lanes.invMass[a];
+      }
+      if (_lanes.invMass[b] != .0f)
+      {
+        _lanes.vx[b] -= ix * _lanes.invMass[b];
+        _lanes.vy[b] -= iy * _lanes.invMass[b];
+      }
+    }
+  }
+}
+
+const KernelTable& GetScalarKernels()
+{
+  static const KernelTable table = { &Intersects, &Project, &Circles, &Integrate, &Contacts };
+  return table;
+}
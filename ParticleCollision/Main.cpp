@@ -1,7 +1,33 @@
 #include "Game.h"
+#include "Kernels.h"
+
+#include <string>
+#include <cstdlib>
+#include <cstdio>
 
 int main(int argc, char* args[])
 {
   Game game;
+
+  //ParticleCollision [--kernels <scalar|sse|avx2|avx512>] [--headless <frames> <file.bmp>]
+  int arg = 1;
+  if (argc >= arg + 2 && std::string(args[arg]) == "--kernels")
+  {
+    KernelLevel level;
+    if (!Kernels::FromName(args[arg + 1], level))
+    {
+      printf("Unknown kernels: %s\n", args[arg + 1]);
+      return 1;
+    }
+
+    Kernels::SetLevel(level);
+    arg += 2;
+  }
+
+  if (argc >= arg + 3 && std::string(args[arg]) == "--headless")
+  {
+    return game.RunHeadless(atoi(args[arg + 1]), args[arg + 2]);
+  }
+
   return game.Run(); //run the game
-}
\ No newline at end of file
+}
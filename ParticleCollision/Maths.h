@@ -2,6 +2,7 @@
 #define _MATH_H_
 
 #include <algorithm>
+#include <cmath>
 
 #include "Vector2.h"
 
@@ -17,9 +18,9 @@ constexpr float DEG2RAD = PI / 180.f;
  * \param [in] _max   Maximum value.
  * \return Returns the clamped value.
  */
-inline float Clamp(float _x, float _min, float _max)
+constexpr float Clamp(float _x, float _min, float _max)
 {
-  return std::max(std::min(_x, _max), _min);
+  return _x < _min ? _min : (_x > _max ? _max : _x);
 }
 
 /**
@@ -30,25 +31,24 @@ inline float Clamp(float _x, float _min, float _max)
  * \param [in] _t Interpolation value.
  * \return Returns the interplated value between a and b.
  */
-inline float Lerp(float _a, float _b, float _t)
+constexpr float Lerp(float _a, float _b, float _t)
 {
-  _t = Clamp(_t, 0.f, 1.f);
-  return _a + (_b - _a) * _t;
+  return _a + (_b - _a) * Clamp(_t, 0.f, 1.f);
 }
 
-inline float Min(float _a, float _b)
+constexpr float Min(float _a, float _b)
 {
-  return std::min(_a, _b);
+  return _b < _a ? _b : _a;
 }
 
-inline float Max(float _a, float _b)
+constexpr float Max(float _a, float _b)
 {
-  return std::max(_a, _b);
+  return _a < _b ? _b : _a;
 }
 
-inline float Abs(float _x)
+constexpr float Abs(float _x)
 {
-	return std::abs(_x);
+	return _x < .0f ? -_x : _x;
 }
 
 inline float Floor(float _x)
@@ -0,0 +1,321 @@
+#include "NarrowPhase.h"
+
+#include "CollisionManager.h"
+#include "CircleBatch.h"
+#include "ThreadPool.h"
+#include "Kernels.h"
+
+const size_t NarrowPhase::TypeCount;
+const size_t NarrowPhase::BatchSize;
+
+namespace
+{
+  /**
+   * \brief Check a batch of pairs with known types.
+   * The types are only ever ordered as CollisionManager::CheckCollision takes them.
+   */
+  template<class A, class B>
+  void CheckPairs(ColliderPair* _pairs, size_t _count, std::vector<CollisionData>& _contacts)
+  {
+    CollisionData data;
+    for (size_t i = 0; i < _count; ++i)
+    {
+      if (CollisionManager::CheckCollision(static_cast<A&>(*_pairs[i].a), static_cast<B&>(*_pairs[i].b), data))
+      {
+        _contacts.push_back(data);
+      }
+    }
+  }
+
+  /**
+   * \brief Check a batch of pairs with known types, skipping the ones that are too far apart.
+   * The gap of each pair tested is measured for the next frame.
+   */
+  template<class A, class B>
+  void CheckGapPairs(ColliderPair* _pairs, size_t _count, std::vector<CollisionData>& _contacts)
+  {
+    CollisionData data;
+    for (size_t i = 0; i < _count; ++i)
+    {
+      ColliderPair& pair = _pairs[i];
+      A& a = static_cast<A&>(*pair.a);
+      B& b = static_cast<B&>(*pair.b);
+
+      //the gap can close by at most how far they have moved relative to each other.
+      Vector2 offset = a.GetPosition() - b.GetPosition();
+      if (pair.gap > .0f && (offset - pair.offset).MagnitudeSq() < pair.gap * pair.gap) { continue; }
+
+      pair.offset = offset;
+      pair.measured = true;
+
+      if (CollisionManager::CheckCollision(a, b, data))
+      {
+        _contacts.push_back(data);
+        pair.gap = .0f;
+      }
+      else
+      {
+        pair.gap = CollisionManager::Separation(a, b);
+      }
+    }
+  }
+}
+
+//indexed by type a * TypeCount + type b, with a never greater than b.
+//order: AABB, CIRCLE, POLYGON, PLANE.
+const NarrowPhase::Kernel NarrowPhase::s_kernels[TypeCount * TypeCount] =
+{
+  nullptr, nullptr,                   nullptr,                       nullptr,
+  nullptr, &CircleBatch::CheckPairs,  &CheckPairs<Circle, Polygon>,  &CheckPairs<Circle, Plane>,
+  nullptr, nullptr,                   &CheckPairs<Polygon, Polygon>, &CheckPairs<Polygon, Plane>,
+  nullptr, nullptr,                   nullptr,                       nullptr
+};
+
+const NarrowPhase::Kernel NarrowPhase::s_gapKernels[TypeCount * TypeCount] =
+{
+  nullptr, nullptr, nullptr,                          nullptr,
+  nullptr, nullptr, &CheckGapPairs<Circle, Polygon>,  nullptr,
+  nullptr, nullptr, &CheckGapPairs<Polygon, Polygon>, &CheckGapPairs<Polygon, Plane>,
+  nullptr, nullptr, nullptr,                          nullptr
+};
+
+NarrowPhase::NarrowPhase() :
+  m_pool(nullptr),
+  m_keepGaps(true),
+  m_frame(0u),
+  m_skipped(0u)
+{ }
+
+NarrowPhase::~NarrowPhase()
+{ }
+
+void NarrowPhase::Clear()
+{
+  for (auto& bucket : m_buckets)
+  {
+    bucket.clear();
+  }
+  m_contacts.clear();
+
+  //forget the pairs the broad-phase did not find last frame.
+  ++m_frame;
+  for (auto it = m_gaps.begin(); it != m_gaps.end();)
+  {
+    if (it->second.frame + 1u < m_frame)
+    {
+      it = m_gaps.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void NarrowPhase::Add(Collider* _a, Collider* _b)
+{
+  //sleeping colliders cannot have moved into each other.
+  if (!_a->IsAwake() && !_b->IsAwake()) { return; }
+
+  size_t typeA = static_cast<size_t>(_a->GetType());
+  size_t typeB = static_cast<size_t>(_b->GetType());
+
+  //keep the lower type first so each combination only has one bucket.
+  ColliderPair pair;
+  size_t bucket;
+  if (typeA > typeB)
+  {
+    pair.a = _b;
+    pair.b = _a;
+    bucket = typeB * TypeCount + typeA;
+  }
+  else
+  {
+    pair.a = _a;
+    pair.b = _b;
+    bucket = typeA * TypeCount + typeB;
+  }
+
+  pair.gap = .0f;
+  pair.measured = false;
+
+  if (KeepsGaps(bucket))
+  {
+    auto it = m_gaps.find(GetKey(pair));
+    if (it != m_gaps.end())
+    {
+      //the offset is kept from the lower id, flip it if a is the other one.
+      it->second.frame = m_frame;
+      pair.gap = it->second.distance;
+      pair.offset = pair.a->GetId() < pair.b->GetId() ? it->second.offset : it->second.offset * -1.f;
+    }
+  }
+
+  m_buckets[bucket].push_back(pair);
+}
+
+void NarrowPhase::Check()
+{
+  m_contacts.clear();
+
+  //a single batch is not worth handing to the threads.
+  if (m_pool == nullptr || GetPairCount() <= BatchSize)
+  {
+    for (size_t i = 0; i < TypeCount * TypeCount; ++i)
+    {
+      if (s_kernels[i] != nullptr && !m_buckets[i].empty())
+      {
+        GetKernel(i)(m_buckets[i].data(), m_buckets[i].size(), m_contacts);
+      }
+    }
+
+    StoreGaps();
+    return;
+  }
+
+  //split the buckets so the threads share the work.
+  m_batches.clear();
+  for (size_t i = 0; i < TypeCount * TypeCount; ++i)
+  {
+    if (s_kernels[i] == nullptr) { continue; }
+
+    for (size_t first = 0; first < m_buckets[i].size(); first += BatchSize)
+    {
+      size_t left = m_buckets[i].size() - first;
+      m_batches.push_back({ i, first, left < BatchSize ? left : BatchSize });
+    }
+  }
+
+  if (m_buffers.size() < m_batches.size())
+  {
+    m_buffers.resize(m_batches.size());
+  }
+
+  //pick the kernels before the threads use them.
+  Kernels::Get();
+
+  m_pool->ParallelFor(m_batches.size(), [this](size_t _batch)
+  {
+    const Batch& batch = m_batches[_batch];
+    std::vector<CollisionData>& buffer = m_buffers[_batch];
+
+    buffer.clear();
+    GetKernel(batch.bucket)(m_buckets[batch.bucket].data() + batch.first, batch.count, buffer);
+  });
+
+  //join in batch order, the same order as checking on one thread.
+  for (size_t i = 0; i < m_batches.size(); ++i)
+  {
+    m_contacts.insert(m_contacts.end(), m_buffers[i].begin(), m_buffers[i].end());
+  }
+
+  StoreGaps();
+}
+
+void NarrowPhase::Resolve()
+{
+  m_solver.Solve(m_contacts);
+}
+
+void NarrowPhase::Collide()
+{
+  Check();
+  Resolve();
+}
+
+void NarrowPhase::SetThreadPool(ThreadPool* _pool)
+{
+  m_pool = _pool;
+}
+
+void NarrowPhase::SetKeepGaps(bool _enabled)
+{
+  m_keepGaps = _enabled;
+
+  //the colliders move on without the gaps being checked.
+  if (!m_keepGaps) { m_gaps.clear(); }
+}
+
+bool NarrowPhase::GetKeepGaps() const
+{
+  return m_keepGaps;
+}
+
+size_t NarrowPhase::GetSkippedCount() const
+{
+  return m_skipped;
+}
+
+bool NarrowPhase::KeepsGaps(size_t _bucket) const
+{
+  return m_keepGaps && s_gapKernels[_bucket] != nullptr;
+}
+
+NarrowPhase::Kernel NarrowPhase::GetKernel(size_t _bucket) const
+{
+  return KeepsGaps(_bucket) ? s_gapKernels[_bucket] : s_kernels[_bucket];
+}
+
+unsigned long long NarrowPhase::GetKey(const ColliderPair& _pair)
+{
+  unsigned long long a = _pair.a->GetId();
+  unsigned long long b = _pair.b->GetId();
+  return a < b ? (a << 32) | b : (b << 32) | a;
+}
+
+void NarrowPhase::StoreGaps()
+{
+  m_skipped = 0u;
+
+  for (size_t i = 0; i < TypeCount * TypeCount; ++i)
+  {
+    if (!KeepsGaps(i)) { continue; }
+
+    for (auto& pair : m_buckets[i])
+    {
+      if (!pair.measured)
+      {
+        m_skipped += pair.gap > .0f;
+        continue;
+      }
+      pair.measured = false;
+
+      //touching pairs are tested every frame.
+      if (pair.gap <= .0f)
+      {
+        m_gaps.erase(GetKey(pair));
+        continue;
+      }
+
+      Gap& gap = m_gaps[GetKey(pair)];
+      gap.offset = pair.a->GetId() < pair.b->GetId() ? pair.offset : pair.offset * -1.f;
+      gap.distance = pair.gap;
+      gap.frame = m_frame;
+    }
+  }
+}
+
+size_t NarrowPhase::GetPairCount() const
+{
+  size_t count = 0u;
+  for (auto& bucket : m_buckets)
+  {
+    count += bucket.size();
+  }
+  return count;
+}
+
+const std::vector<CollisionData>& NarrowPhase::GetContacts() const
+{
+  return m_contacts;
+}
+
+ContactSolver& NarrowPhase::GetSolver()
+{
+  return m_solver;
+}
+
+const ContactSolver& NarrowPhase::GetSolver() const
+{
+  return m_solver;
+}
@@ -0,0 +1,153 @@
+#ifndef _NARROWPHASE_H_
+#define _NARROWPHASE_H_
+
+#include <vector>
+#include <unordered_map>
+
+#include "CollisionData.h"
+#include "ContactSolver.h"
+
+class Collider;
+class ThreadPool;
+
+/**
+ * \brief Two colliders found by a broad-phase.
+ */
+
+struct ColliderPair
+{
+ public:
+  Collider* a; //!< First collider, the lower type.
+  Collider* b; //!< Second collider.
+
+  Vector2 offset; //!< Position of a from b when the gap was measured.
+  float gap; //!< Least distance between the colliders at the offset, 0 if not known.
+  bool measured; //!< Was the gap measured by the last check?
+};
+
+/**
+ * \brief Check the pairs found by a broad-phase.
+ * Pairs are sorted into a bucket for each combination of collider
+ * types, then every bucket is passed to the kernel for those types.
+ * The kernels call the typed checks directly, so there is no virtual
+ * dispatch per pair, and each kernel only ever sees one kind of pair.
+ * The checks only read the colliders, so with a thread pool the buckets
+ * are split into batches that are checked at the same time, each into
+ * its own buffer. The buffers are joined in batch order, so the contacts
+ * come out in the same order as checking on one thread.
+ * The collisions found are resolved together by a ContactSolver after
+ * all buckets are checked.
+ * Pairs with a polygon keep the gap between them from frame to frame.
+ * Colliders never rotate, so a pair cannot touch until the colliders
+ * have moved further relative to each other than the gap, and until
+ * then the pair is skipped without running its test. Circle pairs
+ * are cheaper to test than to look up, so they are not kept.
+ * Keep the object between frames so the storage and gaps are reused.
+ */
+
+class NarrowPhase
+{
+ public:
+  static const size_t TypeCount = 4; //!< Number of collider types.
+  static const size_t BatchSize = 256; //!< Pairs checked by a thread at a time, a multiple of the circle batch width.
+
+  /**
+   * \brief Check a batch of pairs of the same types.
+   * \param [in, out] _pairs    First pair of the batch, kernels that keep gaps update them.
+   * \param [in]      _count    Number of pairs.
+   * \param [in, out] _contacts List to append the collisions to.
+   */
+  using Kernel = void(*)(ColliderPair* _pairs, size_t _count, std::vector<CollisionData>& _contacts);
+
+  NarrowPhase(); //!< Constructor.
+  ~NarrowPhase(); //!< Destructor.
+
+  void Clear(); //!< Remove all pairs and contacts, keeping the storage. Starts a new frame for the gaps.
+
+  /**
+   * \brief Add a pair to the bucket of its types.
+   * Pairs where neither collider is awake are skipped.
+   * The pair's gap from the last frame is looked up.
+   * \param [in] _a
+   * \param [in] _b
+   */
+  void Add(Collider* _a, Collider* _b);
+
+  void Check(); //!< Run the kernel of each bucket, storing the collisions found. Does not change the colliders.
+  void Resolve(); //!< Resolve every collision found.
+
+  void Collide(); //!< Check and resolve the pairs.
+
+  /**
+   * \brief Check the pairs on threads.
+   * \param [in] _pool Threads to use, nullptr checks them on the calling thread.
+   */
+  void SetThreadPool(ThreadPool* _pool);
+
+  size_t GetPairCount() const; //!< Get the number of pairs added.
+  /**
+   * \brief Keep the gaps of the pairs to skip the ones too far apart to touch.
+   * Turning it off forgets the gaps, every pair is checked.
+   * \param [in] _enabled Should the gaps be kept?
+   */
+  void SetKeepGaps(bool _enabled);
+  bool GetKeepGaps() const; //!< Are the gaps kept?
+
+  size_t GetSkippedCount() const; //!< Get the number of pairs the last check skipped as too far apart to touch.
+  const std::vector<CollisionData>& GetContacts() const; //!< Get the collisions found.
+
+  ContactSolver& GetSolver(); //!< Get the solver that resolves the collisions.
+  const ContactSolver& GetSolver() const; //!< Get the solver that resolves the collisions.
+
+ private:
+  static const Kernel s_kernels[TypeCount * TypeCount]; //!< Kernel for each combination of types, nullptr if they cannot collide.
+  static const Kernel s_gapKernels[TypeCount * TypeCount]; //!< Kernel that keeps gaps for each combination, nullptr if its pairs are not kept.
+
+  bool KeepsGaps(size_t _bucket) const; //!< Are the gaps of a bucket's pairs kept?
+  Kernel GetKernel(size_t _bucket) const; //!< Get the kernel to check a bucket with.
+
+  /**
+   * \brief Gap between two colliders, kept between frames.
+   */
+  struct Gap
+  {
+    Vector2 offset; //!< Position of the lower id collider from the other when measured.
+    float distance; //!< Least distance between the colliders.
+    unsigned int frame; //!< Last frame the broad-phase found the pair.
+  };
+
+  /**
+   * \brief Get the key of a pair that is the same whichever collider is first.
+   * \param [in] _pair Pair to key.
+   * \return Returns the ids of the colliders, lowest in the high bits.
+   */
+  static unsigned long long GetKey(const ColliderPair& _pair);
+
+  void StoreGaps(); //!< Keep the gaps measured by the last check.
+
+  /**
+   * \brief Part of a bucket checked by one thread.
+   */
+  struct Batch
+  {
+    size_t bucket; //!< Bucket of the pairs.
+    size_t first; //!< First pair in the bucket.
+    size_t count; //!< Number of pairs.
+  };
+
+  std::vector<ColliderPair> m_buckets[TypeCount * TypeCount]; //!< Pairs sorted by their types.
+  std::vector<CollisionData> m_contacts; //!< Collisions found.
+
+  std::vector<Batch> m_batches; //!< Batches of the current check.
+  std::vector<std::vector<CollisionData>> m_buffers; //!< Collisions found by each batch, kept for the storage.
+  ThreadPool* m_pool; //!< Threads to check on, nullptr for the calling thread.
+  bool m_keepGaps; //!< Are the gaps kept to skip pairs?
+
+  std::unordered_map<unsigned long long, Gap> m_gaps; //!< Gaps of the pairs that were apart, by key.
+  unsigned int m_frame; //!< Number of times Clear has been called.
+  size_t m_skipped; //!< Pairs skipped by the last check.
+
+  ContactSolver m_solver; //!< Resolves the collisions, keeping the impulses between frames.
+};
+
+#endif //_NARROWPHASE_H_
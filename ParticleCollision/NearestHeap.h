@@ -0,0 +1,148 @@
+#ifndef _NEARESTHEAP_H_
+#define _NEARESTHEAP_H_
+
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+/**
+ * \brief Item found by a nearest neighbour search.
+ */
+template <class T>
+struct Neighbour
+{
+ public:
+  T* item; //!< Item found.
+  float distance; //!< Distance from the search point.
+};
+
+/**
+ * \brief Working storage for nearest neighbour searches.
+ * Holds the queue of nodes to visit, closest first, and the
+ * closest items found so far. Keep the object between searches
+ * so the storage is reused.
+ */
+template <class T>
+class NearestHeap
+{
+ public:
+  /**
+   * \brief Node waiting to be searched.
+   */
+  struct Node
+  {
+   public:
+    float distance; //!< Distance from the search point to the node's bounds.
+    int index; //!< Index of the node in the tree.
+    int flags; //!< Extra information the tree keeps with the node.
+  };
+
+  NearestHeap() :
+    m_count(0u), m_maxDistance(.0f)
+  { } //!< Constructor.
+
+  /**
+   * \brief Start a new search.
+   * \param [in] _count       Maximum number of items to find.
+   * \param [in] _maxDistance Ignore items further than this.
+   */
+  void Reset(size_t _count, float _maxDistance = std::numeric_limits<float>().max())
+  {
+    m_count = _count;
+    m_maxDistance = _maxDistance;
+    m_results.clear();
+    m_nodes.clear();
+  }
+
+  float Bound() const
+  {
+    //nothing can be added to a search for no items.
+    if (m_count == 0u) { return -1.f; }
+    return m_results.size() < m_count ? m_maxDistance : m_results.front().distance;
+  } //!< Get the distance an item must be within to be added, negative if none can be.
+
+  /**
+   * \brief Add an item if it is closer than the items found.
+   * \param [in] _item     Item to add.
+   * \param [in] _distance Distance from the search point.
+   */
+  void Push(T* _item, float _distance)
+  {
+    if (m_count == 0u || _distance > Bound()) { return; }
+
+    //keep the furthest item at the front so it can be replaced.
+    m_results.push_back({ _item, _distance });
+    std::push_heap(m_results.begin(), m_results.end(), Further);
+
+    if (m_results.size() > m_count)
+    {
+      std::pop_heap(m_results.begin(), m_results.end(), Further);
+      m_results.pop_back();
+    }
+  }
+
+  /**
+   * \brief Add a node to search.
+   * \param [in] _index    Index of the node.
+   * \param [in] _distance Distance from the search point to the node.
+   * \param [in] _flags    Extra information to keep with the node.
+   */
+  void PushNode(int _index, float _distance, int _flags = 0)
+  {
+    if (_distance > Bound()) { return; }
+
+    m_nodes.push_back({ _distance, _index, _flags });
+    std::push_heap(m_nodes.begin(), m_nodes.end(), NodeFurther);
+  }
+
+  /**
+   * \brief Get the closest node left to search.
+   * \param [out] _node Node to search.
+   * \return Returns false once no remaining node can hold a closer item.
+   */
+  bool PopNode(Node& _node)
+  {
+    if (m_nodes.empty()) { return false; }
+
+    std::pop_heap(m_nodes.begin(), m_nodes.end(), NodeFurther);
+    _node = m_nodes.back();
+    m_nodes.pop_back();
+
+    //the nodes come out closest first, so if this one is too far, so are the rest.
+    if (_node.distance > Bound())
+    {
+      m_nodes.clear();
+      return false;
+    }
+    return true;
+  }
+
+  void Sort()
+  {
+    std::sort_heap(m_results.begin(), m_results.end(), Further);
+  } //!< Order the results closest first. Call once the search has finished.
+
+  const std::vector<Neighbour<T>>& GetResults() const
+  {
+    return m_results;
+  } //!< Get the items found.
+
+ private:
+  static bool Further(const Neighbour<T>& _a, const Neighbour<T>& _b)
+  {
+    return _a.distance < _b.distance;
+  } //!< Order for a heap with the furthest item at the front.
+
+  static bool NodeFurther(const Node& _a, const Node& _b)
+  {
+    return _a.distance > _b.distance;
+  } //!< Order for a heap with the closest node at the front.
+
+  std::vector<Neighbour<T>> m_results; //!< Closest items found, as a heap.
+  std::vector<Node> m_nodes; //!< Nodes to search, as a heap.
+
+  size_t m_count; //!< Maximum number of items to find.
+  float m_maxDistance; //!< Maximum distance of an item.
+};
+
+#endif //_NEARESTHEAP_H_
@@ -1,6 +1,7 @@
 #include "Plane.h"
 
 #include "CollisionManager.h"
+#include "SDL_Functions.h"
 
 Plane::Plane(const Vector2 &_position, const Vector2& _normal, float _width) : 
 	Collider(ColliderType::PLANE, _position, Vector2(0,0)),
@@ -8,6 +9,8 @@ Plane::Plane(const Vector2 &_position, const Vector2& _normal, float _width) :
 	m_width(_width * .5f)
 {
   m_invMass = 0.f;
+  //planes never move, so they are left out of the simulation.
+  SetAwake(false);
 
 	Range x = MinMaxOnAxis(Vector2(1, 0));
 	Range y = MinMaxOnAxis(Vector2(0, 1));
@@ -16,8 +19,11 @@ Plane::Plane(const Vector2 &_position, const Vector2& _normal, float _width) :
 
 void Plane::Draw(Renderer& _renderer)
 {
-  Vector2 min(Min()), max(Max());
-  SDL_RenderDrawLine(_renderer.Get(), min.x, min.y, max.x, max.y);
+  Vector2 min(_renderer.ToScreen(Min())), max(_renderer.ToScreen(Max()));
+  SDL::DrawLine(_renderer,
+    static_cast<int>(min.x), static_cast<int>(min.y),
+    static_cast<int>(max.x), static_cast<int>(max.y)
+  );
 }
 
 bool Plane::CheckCollision(Collider& _other, CollisionData& _data)
@@ -61,4 +67,19 @@ Range Plane::MinMaxOnAxis(const Vector2 &_axis) const
 	range.max = Vector2::Dot(Max(), _axis);
   range.Sort();
   return range;
-}
\ No newline at end of file
+}
+
+float Plane::Distance(const Vector2& _point) const
+{
+  Vector2 min(Min()), max(Max());
+  Vector2 edge = max - min;
+
+  //get the closest point on the plane's edge.
+  float t = Clamp(Vector2::Dot(_point - min, edge) / edge.MagnitudeSq(), 0.f, 1.f);
+  return (_point - (min + edge * t)).Magnitude();
+}
+
+bool Plane::Raycast(const Ray& _ray, float _maxDistance, RayHit& _hit) const
+{
+  return CollisionManager::Raycast(_ray, *this, _maxDistance, _hit);
+}
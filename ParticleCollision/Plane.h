@@ -50,6 +50,22 @@ public:
    */
   Range MinMaxOnAxis(const Vector2& _axis) const override;
 
+  /**
+   * \brief Get the distance from a point to the plane.
+   * \param [in] _point Point in world space.
+   * \return Returns the distance to the closest point on the plane.
+   */
+  float Distance(const Vector2& _point) const override;
+
+  /**
+   * \brief Check if a ray hits the plane.
+   * \param [in]  _ray         Ray to cast.
+   * \param [in]  _maxDistance Ignore hits further than this.
+   * \param [out] _hit         Information about the hit.
+   * \return Returns true if the ray hits the plane.
+   */
+  bool Raycast(const Ray& _ray, float _maxDistance, RayHit& _hit) const override;
+
   Vector2 Min() const; //!< Get the minimum point in world space.
   Vector2 Max() const; //!< Get the maximum point in world space.
 
@@ -1,68 +1,75 @@
 #include "Polygon.h"
 
 #include "CollisionManager.h"
+#include "SDL_Functions.h"
+#include "VertexArena.h"
 
 Polygon::Polygon(const Vector2& _position, const Vector2& _velocity) : Collider(ColliderType::POLYGON, _position, _velocity)
 {
   GenerateRandom(10, 40, 5);
 }
 
-void Polygon::GenerateRandom(float _minSize, float _maxSize, int _vertexCount)
+Polygon::Polygon(const std::shared_ptr<const PolygonShape>& _shape, const Vector2& _position, const Vector2& _velocity) :
+  Collider(ColliderType::POLYGON, _position, _velocity)
 {
-  //allocate enough storage for the points.
-  m_points.resize(_vertexCount);
-
-  float curAngle = 0.f; 
-  float step = 360.f / _vertexCount; //angle differnce between vertices.
-  float averageDistance = 0.f;
+  SetShape(_shape);
+}
 
-  //range of sizes.
-  int sizeDiff = static_cast<int>(_maxSize - _minSize);
+void Polygon::GenerateRandom(float _minSize, float _maxSize, int _vertexCount)
+{
+  SetShape(PolygonShape::CreateRandom(_minSize, _maxSize, _vertexCount));
+}
 
-  //set the positions of each vertex.
-  for (size_t i = 0; i < m_points.size(); ++i)
-  {
-    curAngle += step;
-
-    //get the direction of the point.
-    Vector2 dir = Vector2::AngleToVector(curAngle * DEG2RAD);
-    //get the distance of the point.
-    float size = _minSize + rand() % sizeDiff;
-    averageDistance += size;
-    
-    m_points[i] = dir * size;
-  }
+void Polygon::SetShape(const std::shared_ptr<const PolygonShape>& _shape)
+{
+  m_shape = _shape;
 
   //set the mass.
-  averageDistance /= m_points.size();
+  float averageDistance = m_shape->GetAverageRadius();
   float area = PI * (averageDistance * averageDistance);
   m_invMass = 1.f / area;
 
-  //update the aabb.
-  Range x = MinMaxOnAxis(Vector2(1, 0));
-  Range y = MinMaxOnAxis(Vector2(0, 1));
-  m_aabb = Rect(x.min, y.min, x.max, y.max);
+  UpdateAABB();
+}
+
+const std::shared_ptr<const PolygonShape>& Polygon::GetShape() const
+{
+  return m_shape;
+}
+
+void Polygon::Update(float _deltaTime)
+{
+  m_position += m_velocity * _deltaTime;
+
+  UpdateAABB();
+}
+
+void Polygon::UpdateAABB()
+{
+  //the polygon does not rotate, so the box only moves.
+  const Rect& bounds = m_shape->GetBounds();
+  m_aabb = Rect(bounds.min + m_position, bounds.max + m_position);
 }
 
 void Polygon::Draw(Renderer& _renderer)
 {
+  size_t count = m_shape->GetPointCount();
+
   //exit if there is not even a line.
-  if (m_points.size() < 2) { return; }
+  if (count < 2) { return; }
 
-  //convert the local points to world space.
-  std::vector<SDL_Point> points(m_points.size() + 1);
+  //draw each edge, connecting back to the first point.
+  Vector2 prev = _renderer.ToScreen(GetPoint(count - 1) + m_position);
 
-  for (size_t i = 0; i < m_points.size(); ++i)
+  for (size_t i = 0; i < count; ++i)
   {
-    points[i].x = static_cast<int>(m_points[i].x + m_position.x);
-    points[i].y = static_cast<int>(m_points[i].y + m_position.y);
+    Vector2 point = _renderer.ToScreen(GetPoint(i) + m_position);
+    SDL::DrawLine(_renderer,
+      static_cast<int>(prev.x),  static_cast<int>(prev.y),
+      static_cast<int>(point.x), static_cast<int>(point.y)
+    );
+    prev = point;
   }
-
-  //connect back to the first point.
-  points[m_points.size()].x = points[0].x;
-  points[m_points.size()].y = points[0].y;
-
-  SDL_RenderDrawLines(_renderer.Get(), &points[0], points.size());
 }
 
 bool Polygon::CheckCollision(Collider& _other, CollisionData& _data)
@@ -88,25 +95,8 @@ bool Polygon::CheckCollision(Plane& _other, CollisionData& _data)
 
 Range Polygon::MinMaxOnAxis(const Vector2& _axis) const 
 {
-  //if there is no points, the object does not exist.
-  if (m_points.empty()) 
-  {
-    throw std::out_of_range("No vertices set.");
-  }
-
-  //project each point onto the axis. Set the min and
-  //max accordingly.
-
-  float tmp = Vector2::Dot(m_points[0], _axis);
-  Range range(tmp, tmp);
-
-  for (size_t i = 1; i < m_points.size(); i++)
-  {
-    tmp = Vector2::Dot(m_points[i], _axis);
-   
-    range.min = ::Min(tmp, range.min);
-    range.max = ::Max(tmp, range.max);
-  }
+  //project all the points onto the axis together.
+  Range range = VertexArena::Get().Project(m_shape->GetPointOffset(), m_shape->GetPointCount(), _axis);
 
   //add the position to move it to world space.
   float pos = Vector2::Dot(m_position, _axis);
@@ -114,4 +104,63 @@ Range Polygon::MinMaxOnAxis(const Vector2& _axis) const
   range.max += pos;
 
   return range;
+}
+
+Range Polygon::GetProjection(size_t _index) const
+{
+  //the range was found when the shape was made, so only the position is needed.
+  Range range = m_shape->GetProjection(_index);
+  float pos = Vector2::Dot(m_position, m_shape->GetAxis(_index));
+  range.min += pos;
+  range.max += pos;
+
+  return range;
+}
+
+float Polygon::Distance(const Vector2& _point) const
+{
+  //work in local space so the points do not need moving.
+  Vector2 point = _point - m_position;
+
+  float distSq = std::numeric_limits<float>().max();
+  bool inside = false;
+
+  size_t count = m_shape->GetPointCount();
+
+  for (size_t i = 0, j = count - 1; i < count; j = i++)
+  {
+    Vector2 a = GetPoint(j);
+    Vector2 b = GetPoint(i);
+    Vector2 edge = b - a;
+
+    //get the closest point on the edge.
+    float lengthSq = edge.MagnitudeSq();
+    float t = lengthSq > .0f ? Clamp(Vector2::Dot(point - a, edge) / lengthSq, 0.f, 1.f) : 0.f;
+    distSq = Min(distSq, (point - (a + edge * t)).MagnitudeSq());
+
+    //count the edges crossed by a ray going right from the point.
+    if ((a.y > point.y) != (b.y > point.y) &&
+        point.x < a.x + (point.y - a.y) * (b.x - a.x) / (b.y - a.y))
+    {
+      inside = !inside;
+    }
+  }
+
+  float dist = sqrt(distSq);
+  return inside ? -dist : dist;
+}
+
+bool Polygon::Raycast(const Ray& _ray, float _maxDistance, RayHit& _hit) const
+{
+  return CollisionManager::Raycast(_ray, *this, _maxDistance, _hit);
+}
+
+size_t Polygon::GetPointCount() const
+{
+  return m_shape->GetPointCount();
+}
+
+Vector2 Polygon::GetPoint(size_t _index) const
+{
+  return m_shape->GetPoint(_index);
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define _POLYGON_H_
 
 #include "Collider.h"
+#include "PolygonShape.h"
 
 /**
  * \brief Define a polygon collider.
@@ -14,6 +15,14 @@ class Polygon : public Collider
  public:
   Polygon(const Vector2& _position, const Vector2& _velocity); //!< Constructor.
 
+  /**
+   * \brief Constructor.
+   * \param [in] _shape    Outline to use, can be shared with other polygons.
+   * \param [in] _position Position of the centre.
+   * \param [in] _velocity Starting velocity.
+   */
+  Polygon(const std::shared_ptr<const PolygonShape>& _shape, const Vector2& _position, const Vector2& _velocity);
+
   /**
    * \brief Create a random polygon.
    * \param [in] _minSize     Minimum distance from the origin.
@@ -22,6 +31,11 @@ class Polygon : public Collider
    */
   void GenerateRandom(float _minSize, float _maxSize, int _vertexCount);
 
+  void SetShape(const std::shared_ptr<const PolygonShape>& _shape); //!< Set the outline. Also sets the mass.
+  const std::shared_ptr<const PolygonShape>& GetShape() const; //!< Get the outline.
+
+  void Update(float _deltaTime) override; //!< Move the polygon and its bounding box.
+
   void Draw(Renderer& _renderer) override; //!< Draw the polygon.
 
   bool CheckCollision(Collider& _other, CollisionData& _data) override; //!< Used for double dispatch.
@@ -57,8 +71,42 @@ class Polygon : public Collider
    */
   Range MinMaxOnAxis(const Vector2& _axis) const override;
 
+  /**
+   * \brief Get the area of the polygon on one of its shape's axes.
+   * \param [in] _index Axis of the shape.
+   * \return Returns the range on the axis.
+   */
+  Range GetProjection(size_t _index) const;
+
+  /**
+   * \brief Get the distance from a point to the polygon.
+   * \param [in] _point Point in world space.
+   * \return Returns the distance to the edges, negative if the point is inside.
+   */
+  float Distance(const Vector2& _point) const override;
+
+  /**
+   * \brief Check if a ray hits the polygon.
+   * \param [in]  _ray         Ray to cast.
+   * \param [in]  _maxDistance Ignore hits further than this.
+   * \param [out] _hit         Information about the hit.
+   * \return Returns true if the ray hits the polygon.
+   */
+  bool Raycast(const Ray& _ray, float _maxDistance, RayHit& _hit) const override;
+
+  size_t GetPointCount() const; //!< Get the number of vertices.
+
+  /**
+   * \brief Get a vertex.
+   * \param [in] _index Vertex to get.
+   * \return Returns the vertex relative to the position.
+   */
+  Vector2 GetPoint(size_t _index) const;
+
  private:
-  std::vector<Vector2> m_points; //!< List of points for the corners (vertices) of the polygon.
+  void UpdateAABB(); //!< Move the shape's bounding box to the position.
+
+  std::shared_ptr<const PolygonShape> m_shape; //!< Outline of the polygon.
 };
 
 #endif //_POLYGON_H_
\ No newline at end of file
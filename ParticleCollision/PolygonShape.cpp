@@ -0,0 +1,141 @@
+#include "PolygonShape.h"
+
+#include <stdexcept>
+
+#include "VertexArena.h"
+
+std::shared_ptr<const PolygonShape> PolygonShape::Create(const std::vector<Vector2>& _points)
+{
+  return std::make_shared<const PolygonShape>(_points);
+}
+
+std::shared_ptr<const PolygonShape> PolygonShape::CreateRandom(float _minSize, float _maxSize, int _vertexCount)
+{
+  std::vector<Vector2> points(_vertexCount);
+
+  float curAngle = 0.f;
+  float step = 360.f / _vertexCount; //angle differnce between vertices.
+
+  //range of sizes.
+  int sizeDiff = static_cast<int>(_maxSize - _minSize);
+
+  //set the positions of each vertex.
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    curAngle += step;
+
+    //get the direction of the point.
+    Vector2 dir = Vector2::AngleToVector(curAngle * DEG2RAD);
+    //get the distance of the point.
+    float size = _minSize + rand() % sizeDiff;
+
+    points[i] = dir * size;
+  }
+
+  return Create(points);
+}
+
+PolygonShape::PolygonShape(const std::vector<Vector2>& _points) :
+  m_pointOffset(0u), m_pointCount(_points.size()),
+  m_radius(.0f), m_averageRadius(.0f)
+{
+  //if there is no points, the shape does not exist.
+  if (m_pointCount == 0u)
+  {
+    throw std::out_of_range("No vertices set.");
+  }
+
+  VertexArena& arena = VertexArena::Get();
+  m_pointOffset = arena.Allocate(m_pointCount);
+  arena.Set(m_pointOffset, _points.data(), m_pointCount);
+
+  //get the size of the shape.
+  m_bounds = Rect(_points[0], _points[0]);
+  for (const Vector2& point : _points)
+  {
+    m_bounds.min.x = Min(m_bounds.min.x, point.x);
+    m_bounds.min.y = Min(m_bounds.min.y, point.y);
+    m_bounds.max.x = Max(m_bounds.max.x, point.x);
+    m_bounds.max.y = Max(m_bounds.max.y, point.y);
+
+    float distance = point.Magnitude();
+    m_radius = Max(m_radius, distance);
+    m_averageRadius += distance;
+  }
+  m_averageRadius /= m_pointCount;
+
+  //get the normal of each edge, skipping edges parallel to one
+  //already added as they would give the same overlap.
+  for (size_t i = 1; i < m_pointCount + 1; ++i)
+  {
+    Vector2 edge = _points[i - 1] - _points[i % m_pointCount];
+    if (edge.MagnitudeSq() == .0f) { continue; }
+
+    Vector2 normal = edge.Normalized().Left();
+
+    bool parallel = false;
+    for (const Vector2& axis : m_axes)
+    {
+      //the cross product is 0 for parallel vectors.
+      if (fabs(normal.x * axis.y - normal.y * axis.x) < 1e-4f)
+      {
+        parallel = true;
+        break;
+      }
+    }
+    if (parallel) { continue; }
+
+    m_axes.push_back(normal);
+    m_projections.push_back(arena.Project(m_pointOffset, m_pointCount, normal));
+  }
+}
+
+PolygonShape::~PolygonShape()
+{
+  VertexArena::Get().Free(m_pointOffset, m_pointCount);
+}
+
+size_t PolygonShape::GetPointCount() const
+{
+  return m_pointCount;
+}
+
+size_t PolygonShape::GetPointOffset() const
+{
+  return m_pointOffset;
+}
+
+Vector2 PolygonShape::GetPoint(size_t _index) const
+{
+  return VertexArena::Get().GetPoint(m_pointOffset, _index);
+}
+
+size_t PolygonShape::GetAxisCount() const
+{
+  return m_axes.size();
+}
+
+const Vector2& PolygonShape::GetAxis(size_t _index) const
+{
+  return m_axes[_index];
+}
+
+const Range& PolygonShape::GetProjection(size_t _index) const
+{
+  return m_projections[_index];
+}
+
+const Rect& PolygonShape::GetBounds() const
+{
+  return m_bounds;
+}
+
+float PolygonShape::GetRadius() const
+{
+  return m_radius;
+}
+
+float PolygonShape::GetAverageRadius() const
+{
+  return m_averageRadius;
+}
@@ -0,0 +1,88 @@
+#ifndef _POLYGONSHAPE_H_
+#define _POLYGONSHAPE_H_
+
+#include <vector>
+#include <memory>
+
+#include "Maths.h"
+#include "Range.h"
+#include "Rect.h"
+
+/**
+ * \brief Convex outline that any number of polygons can share.
+ * Everything that only depends on the vertices is worked out once
+ * when the shape is created. Polygons never rotate, so the edge
+ * normals, the bounding box and the range of the vertices on each
+ * normal stay the same in local space, and only need the position
+ * added to move them into world space.
+ */
+
+class PolygonShape
+{
+ public:
+  /**
+   * \brief Create a shape.
+   * \param [in] _points Vertices in order around the outline, relative to the centre.
+   * \return Returns the new shape.
+   */
+  static std::shared_ptr<const PolygonShape> Create(const std::vector<Vector2>& _points);
+
+  /**
+   * \brief Create a random shape.
+   * \param [in] _minSize     Minimum distance from the origin.
+   * \param [in] _maxSize     Maximum distance from the origin.
+   * \param [in] _vertexCount Number of vertices to create.
+   * \return Returns the new shape.
+   */
+  static std::shared_ptr<const PolygonShape> CreateRandom(float _minSize, float _maxSize, int _vertexCount);
+
+  PolygonShape(const std::vector<Vector2>& _points); //!< Constructor. Use Create.
+  ~PolygonShape(); //!< Destructor.
+
+  PolygonShape(const PolygonShape&) = delete; //!< The vertex block can only have one owner.
+  PolygonShape& operator=(const PolygonShape&) = delete; //!< The vertex block can only have one owner.
+
+  size_t GetPointCount() const; //!< Get the number of vertices.
+  size_t GetPointOffset() const; //!< Get the start of the vertices in the vertex arena.
+
+  /**
+   * \brief Get a vertex.
+   * \param [in] _index Vertex to get.
+   * \return Returns the vertex relative to the centre.
+   */
+  Vector2 GetPoint(size_t _index) const;
+
+  size_t GetAxisCount() const; //!< Get the number of separating axes.
+
+  /**
+   * \brief Get a separating axis.
+   * Parallel edges share one axis, so there can be fewer axes than edges.
+   * \param [in] _index Axis to get.
+   * \return Returns the unit normal.
+   */
+  const Vector2& GetAxis(size_t _index) const;
+
+  /**
+   * \brief Get the range of the vertices on a separating axis.
+   * \param [in] _index Axis to get.
+   * \return Returns the range relative to the centre.
+   */
+  const Range& GetProjection(size_t _index) const;
+
+  const Rect& GetBounds() const; //!< Get the bounding box relative to the centre.
+  float GetRadius() const; //!< Get the distance to the furthest vertex.
+  float GetAverageRadius() const; //!< Get the average distance to the vertices.
+
+ private:
+  size_t m_pointOffset; //!< Start of the vertices in the vertex arena.
+  size_t m_pointCount; //!< Number of vertices.
+
+  std::vector<Vector2> m_axes; //!< Unit edge normals, without parallel duplicates.
+  std::vector<Range> m_projections; //!< Range of the vertices on each axis.
+
+  Rect m_bounds; //!< Bounding box relative to the centre.
+  float m_radius; //!< Distance to the furthest vertex.
+  float m_averageRadius; //!< Average distance to the vertices.
+};
+
+#endif //_POLYGONSHAPE_H_
@@ -1,21 +1,27 @@
 #include "Profiler.h"
 
-#include <sstream>
-#include <limits>
-#include <iomanip>
+#include <cstdio>
+#include <cmath>
+#include <cstdarg>
 
-Profiler::Profiler(std::shared_ptr<Font> _font)
+#include "Renderer.h"
+
+Profiler::Profiler(std::shared_ptr<Font> _font) :
+  m_font(_font)
 {
   Reset();
-  m_fpsText.SetFont(_font);
-  m_minText.SetFont(_font);
-  m_maxText.SetFont(_font);
-  m_avgText.SetFont(_font);
-
-  m_fpsText.SetText("FPS: 0.0 (0.0000ms)");
-  m_minText.SetText("Min: 0.0");
-  m_maxText.SetText("Max: 0.0");
-  m_avgText.SetText("Avg: 0.0");
+  m_colour.r = m_colour.g = m_colour.b = 0;
+  m_colour.a = 255;
+
+  snprintf(m_fpsText, TextSize, "FPS: 0.0 (0.0000ms)");
+  snprintf(m_minText, TextSize, "Min: 0.0");
+  snprintf(m_maxText, TextSize, "Max: 0.0");
+  snprintf(m_avgText, TextSize, "Avg: 0.0");
+
+  for (int i = 0; i < StatCount; ++i)
+  {
+    m_statText[i][0] = '\0';
+  }
 }
 
 Profiler::~Profiler()
@@ -39,40 +45,40 @@ void Profiler::Update(float _deltaTime)
   
   m_average = (m_frames == 0u) ? fps : (m_average + fps) * .5f;
 
-  std::stringstream ss;
-
+  //write into the fixed buffers, nothing is allocated.
   if (m_updateTimer.Seconds() > .1f)
   {
     m_updateTimer.Reset();
 
-    ss << "FPS: " << std::fixed << std::setprecision(1) << fps << " (" << std::setprecision(4) << _deltaTime << "ms)";
-    m_fpsText.SetText(ss.str());
-
-    ss.str(std::string());
-
-    ss << "Avg: " << std::fixed << std::setprecision(1) << m_average;
-    m_avgText.SetText(ss.str());
-
-    ss.str(std::string());
+    snprintf(m_fpsText, TextSize, "FPS: %.1f (%.4fms)", fps, _deltaTime);
+    snprintf(m_avgText, TextSize, "Avg: %.1f", m_average);
   }
 
-  ss << "Min: " << std::fixed << std::setprecision(1) << m_min;
-  m_minText.SetText(ss.str());
-
-  ss.str(std::string());
-
-  ss << "Max: " << std::fixed << std::setprecision(1) << m_max;
-  m_maxText.SetText(ss.str());
+  snprintf(m_minText, TextSize, "Min: %.1f", m_min);
+  snprintf(m_maxText, TextSize, "Max: %.1f", m_max);
 
   ++m_frames;
 }
 
 void Profiler::Render(Renderer& _renderer)
 {
-  m_fpsText.Draw(_renderer, 10, 10);
-  m_minText.Draw(_renderer, 10, 40);
-  m_maxText.Draw(_renderer, 10, 70);
-  m_avgText.Draw(_renderer, 300, 10);
+  //the glyphs are only rasterized once.
+  if (!m_glyphs.IsCreated())
+  {
+    if (!m_font || !m_glyphs.Create(_renderer, *m_font)) { return; }
+  }
+
+  m_glyphs.Add(m_fpsText, 10, 10, m_colour);
+  m_glyphs.Add(m_minText, 10, 40, m_colour);
+  m_glyphs.Add(m_maxText, 10, 70, m_colour);
+  m_glyphs.Add(m_avgText, 300, 10, m_colour);
+
+  for (int i = 0; i < StatCount; ++i)
+  {
+    if (m_statText[i][0] != '\0') { m_glyphs.Add(m_statText[i], 10, 100 + i * 30, m_colour); }
+  }
+
+  m_glyphs.Flush(_renderer);
 }
 
 void Profiler::Reset()
@@ -81,4 +87,14 @@ void Profiler::Reset()
   m_max = 0.f;//std::numeric_limits<float>().min();
   m_average = 0.f;
   m_frames = 0u;
-}
\ No newline at end of file
+}
+
+void Profiler::SetStat(int _line, const char* _format, ...)
+{
+  if (_line < 0 || _line >= StatCount) { return; }
+
+  va_list args;
+  va_start(args, _format);
+  vsnprintf(m_statText[_line], TextSize, _format, args);
+  va_end(args);
+}
@@ -1,12 +1,16 @@
 #ifndef _PROFILER_H_
 #define _PROFILER_H_
 
-#include "Text.h"
+#include <memory>
+
+#include "Font.h"
+#include "GlyphAtlas.h"
 #include "Timer.h"
 
 /**
  * \brief Store time statisics.
- * Displays current fps, minimum fps and maximum fps.
+ * Displays current fps, minimum fps and maximum fps,
+ * and under them any lines of statistics the game sets.
  */
 class Profiler
 {
@@ -20,16 +24,33 @@ class Profiler
 
   void Reset(); //!< Reset the minimum and maximum.
 
+  /**
+   * \brief Set a line of statistics shown under the frame rate.
+   * The text is written into a fixed buffer, nothing is allocated.
+   * \param [in] _line   Line to set, from 0 to StatCount - 1.
+   * \param [in] _format printf format of the text, followed by its arguments.
+   */
+  void SetStat(int _line, const char* _format, ...);
+
+  static const int StatCount = 8; //!< Number of lines of statistics.
+
  private:
   float m_min; //!< Minimum fps.
   float m_max; //!< Maximum fps.
 
   float m_average; //!< Average fps.
 
-  Text m_fpsText; //!< Current fps text to display.
-  Text m_minText; //!< Minimum fps text to display.
-  Text m_maxText; //!< Maximum fps text to display.
-  Text m_avgText; //!< Average fps text to display.
+  static const int TextSize = 32; //!< Size of the text buffers.
+
+  char m_fpsText[TextSize]; //!< Current fps text to display.
+  char m_minText[TextSize]; //!< Minimum fps text to display.
+  char m_maxText[TextSize]; //!< Maximum fps text to display.
+  char m_avgText[TextSize]; //!< Average fps text to display.
+  char m_statText[StatCount][TextSize]; //!< Lines of statistics to display, empty if not set.
+
+  std::shared_ptr<Font> m_font; //!< Font of the text.
+  GlyphAtlas m_glyphs; //!< Glyphs of the font, made on the first render.
+  SDL_Color m_colour; //!< Colour of the text.
 
   Timer m_updateTimer; //!< Timer to update.
   unsigned int m_frames; //!< number of frames since last reset.
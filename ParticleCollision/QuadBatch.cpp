@@ -0,0 +1,100 @@
+#include "QuadBatch.h"
+
+#include "Texture.h"
+
+QuadBatch::QuadBatch()
+{ }
+
+QuadBatch::~QuadBatch()
+{ }
+
+void QuadBatch::AddQuad(const SDL_Rect& _src, float _x, float _y, float _width, float _height, const SDL_Color& _colour)
+{
+  m_quads.push_back({ _src, _x, _y, _width, _height, _colour });
+}
+
+void QuadBatch::Flush(SDL_Renderer* _renderer, const Texture& _texture)
+{
+  if (m_quads.empty()) { return; }
+
+  SDL_Texture* texture = _texture.Get();
+
+#ifdef QUADBATCH_GEOMETRY
+  float invWidth = 1.f / _texture.GetWidth();
+  float invHeight = 1.f / _texture.GetHeight();
+
+  m_vertices.resize(m_quads.size() * 4);
+  for (size_t i = 0; i < m_quads.size(); ++i)
+  {
+    const Quad& q = m_quads[i];
+
+    float u0 = q.src.x * invWidth, v0 = q.src.y * invHeight;
+    float u1 = (q.src.x + q.src.w) * invWidth, v1 = (q.src.y + q.src.h) * invHeight;
+    float x1 = q.x + q.width, y1 = q.y + q.height;
+
+    SDL_Vertex* v = &m_vertices[i * 4];
+    v[0] = { { q.x, q.y }, q.colour, { u0, v0 } };
+    v[1] = { { x1,  q.y }, q.colour, { u1, v0 } };
+    v[2] = { { q.x, y1  }, q.colour, { u0, v1 } };
+    v[3] = { { x1,  y1  }, q.colour, { u1, v1 } };
+  }
+
+  //every quad uses the same pattern, so the indices
+  //are only added the first time that many quads are drawn.
+  int quads = static_cast<int>(m_quads.size());
+  for (int i = static_cast<int>(m_indices.size() / 6); i < quads; ++i)
+  {
+    int v = i * 4;
+    m_indices.insert(m_indices.end(), { v, v + 1, v + 2, v + 2, v + 1, v + 3 });
+  }
+
+  SDL_RenderGeometry(
+    _renderer, texture,
+    &m_vertices[0], static_cast<int>(m_vertices.size()),
+    &m_indices[0], quads * 6
+  );
+#else
+  //only change the tint when it is different to the last quad.
+  SDL_Color colour = m_quads[0].colour;
+  SDL_SetTextureColorMod(texture, colour.r, colour.g, colour.b);
+  SDL_SetTextureAlphaMod(texture, colour.a);
+
+  for (auto& q : m_quads)
+  {
+    if (q.colour.r != colour.r || q.colour.g != colour.g ||
+        q.colour.b != colour.b || q.colour.a != colour.a)
+    {
+      colour = q.colour;
+      SDL_SetTextureColorMod(texture, colour.r, colour.g, colour.b);
+      SDL_SetTextureAlphaMod(texture, colour.a);
+    }
+
+    SDL_Rect dst = {
+      static_cast<int>(q.x), static_cast<int>(q.y),
+      static_cast<int>(q.width + .5f), static_cast<int>(q.height + .5f)
+    };
+    SDL_RenderCopy(_renderer, texture, &q.src, &dst);
+  }
+#endif
+
+  Clear();
+}
+
+void QuadBatch::Clear()
+{
+  m_quads.clear();
+}
+
+bool QuadBatch::Empty() const
+{
+  return m_quads.empty();
+}
+
+bool QuadBatch::IsBatched()
+{
+#ifdef QUADBATCH_GEOMETRY
+  return true;
+#else
+  return false;
+#endif
+}
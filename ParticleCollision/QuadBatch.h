@@ -0,0 +1,72 @@
+#ifndef _QUADBATCH_H_
+#define _QUADBATCH_H_
+
+#include <vector>
+
+#include "SDL.h"
+
+class Texture;
+
+//SDL_RenderGeometry was added in 2.0.18, older versions
+//copy each quad from the texture instead.
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  #define QUADBATCH_GEOMETRY
+#endif
+
+/**
+ * \brief Collect textured quads from one texture.
+ * With SDL_RenderGeometry all the quads are drawn in one call from
+ * a vertex buffer that is kept between frames.
+ */
+
+class QuadBatch
+{
+ public:
+  QuadBatch(); //!< Constructor.
+  ~QuadBatch(); //!< Destructor.
+
+  /**
+   * \brief Add a quad.
+   * \param [in] _src    Area of the texture.
+   * \param [in] _x      Left of the quad in pixels.
+   * \param [in] _y      Top of the quad in pixels.
+   * \param [in] _width  Width of the quad in pixels.
+   * \param [in] _height Height of the quad in pixels.
+   * \param [in] _colour Tint of the quad.
+   */
+  void AddQuad(const SDL_Rect& _src, float _x, float _y, float _width, float _height, const SDL_Color& _colour);
+
+  /**
+   * \brief Draw everything in the batch and empty it.
+   * \param [in, out] _renderer Renderer to draw to.
+   * \param [in]      _texture  Texture the quads are taken from.
+   */
+  void Flush(SDL_Renderer* _renderer, const Texture& _texture);
+
+  void Clear(); //!< Empty the batch, keeping the storage.
+
+  bool Empty() const; //!< Is there anything to draw?
+
+  static bool IsBatched(); //!< Are all the quads drawn in one call? False when each is copied on its own.
+
+ private:
+  /**
+   * \brief Area of the texture to copy to the screen.
+   */
+  struct Quad
+  {
+    SDL_Rect src; //!< Area of the texture.
+    float x, y; //!< Top left on the screen.
+    float width, height; //!< Size on the screen.
+    SDL_Color colour; //!< Tint.
+  };
+
+  std::vector<Quad> m_quads; //!< Quads to draw.
+
+#ifdef QUADBATCH_GEOMETRY
+  std::vector<SDL_Vertex> m_vertices; //!< Four corners of every quad.
+  std::vector<int> m_indices; //!< Two triangles of every quad, only grows.
+#endif
+};
+
+#endif //_QUADBATCH_H_
@@ -4,7 +4,12 @@
 #include "QuadTree_Node.h"
 #include "QuadTree_Pair.h"
 
+#include "RayPacket.h"
+#include "NearestHeap.h"
+#include "DebugDraw.h"
+
 #include <iostream>
+#include <algorithm>
 
 namespace QuadTree
 {
@@ -60,10 +65,20 @@ namespace QuadTree
       InsertInto(m_root, _item);
     } //!< Add an item to the tree.
 
-    void Draw(Renderer& _renderer)
+    /**
+     * \brief Add an item to the leaves its bounds reach that do not hold it yet.
+     * The item must already be in the tree, with bounds that only grew since.
+     * \param [in] _item Item to update.
+     */
+    void Grow(T* _item)
+    {
+      GrowInto(m_root, _item);
+    }
+
+    void Draw(DebugDraw& _debug) const
     {
-      Draw(m_root, _renderer);
-    } //!< Draw the nodes.
+      Draw(m_root, _debug, true, true);
+    } //!< Add the nodes and items to draw.
 
     /**
      * \brief Get a list of potential overlaps.
@@ -74,7 +89,300 @@ namespace QuadTree
       GetPairs(m_root, _pairs);
     }
 
+    /**
+     * \brief Find the items with a bounding box overlapping an area.
+     * Each item is only reported once, even if it is in multiple leaves.
+     * \param [in] _rect     Area to search.
+     * \param [in] _callback Function called with each item found.
+     */
+    template <class Callback>
+    void Query(const Rect& _rect, Callback&& _callback) const
+    {
+      Query(m_root, _rect, true, true, _callback);
+    }
+
+    /**
+     * \brief Cast a ray through the tree, visiting the closest nodes first.
+     * Items in several leaves may be tested more than once.
+     * \param [in] _ray      Ray to cast.
+     * \param [in] _callback Function called with each item the ray may hit and the
+     *                       distance of the closest hit so far. Returns the distance
+     *                       of the closest hit after testing the item.
+     */
+    template <class Callback>
+    void Raycast(const Ray& _ray, Callback&& _callback) const
+    {
+      float maxDistance = _ray.length;
+      float distance;
+      if (_ray.Intersects(m_nodes[m_root].rect, maxDistance, distance))
+      {
+        Raycast(m_root, _ray, maxDistance, _callback);
+      }
+    }
+
+    /**
+     * \brief Cast a packet of rays through the tree.
+     * Every node is tested against all the rays in the packet at once.
+     * \param [in, out] _packet   Rays to cast. The max distances are updated with the hits.
+     * \param [in]      _callback Function called with each item, the index of the ray
+     *                            and the distance of its closest hit. Returns the distance
+     *                            of the ray's closest hit after testing the item.
+     */
+    template <class Callback>
+    void Raycast(RayPacket& _packet, Callback&& _callback) const
+    {
+      float distance[RayPacket::Size];
+      int mask = _packet.Intersects(m_nodes[m_root].rect, distance);
+      if (mask != 0)
+      {
+        Raycast(m_root, _packet, mask, _callback);
+      }
+    }
+
+    /**
+     * \brief Find the closest items to a point.
+     * Nodes are searched closest first, until the rest are too far
+     * away to hold a closer item.
+     * \param [in]      _point    Position to search from.
+     * \param [in, out] _heap     Search storage, reset by the caller. Holds the items found.
+     * \param [in]      _distance Function returning the distance from the point to an item.
+     */
+    template <class Distance>
+    void Nearest(const Vector2& _point, NearestHeap<T>& _heap, Distance&& _distance) const
+    {
+      _heap.PushNode(m_root, m_nodes[m_root].rect.Distance(_point), EdgeX | EdgeY);
+
+      typename NearestHeap<T>::Node node;
+      while (_heap.PopNode(node))
+      {
+        const NodeType& current = m_nodes[node.index];
+
+        if (current.IsLeaf())
+        {
+          for (size_t i = 0; i < current.items.size(); ++i)
+          {
+            T* item = current.items[i];
+            const Rect& aabb = item->GetAABB();
+
+            if (aabb.Distance(_point) > _heap.Bound()) { continue; }
+
+            //items can be in several leaves. only test the item from the
+            //leaf that holds the closest point of its bounds.
+            Vector2 closest(Clamp(_point.x, aabb.min.x, aabb.max.x), Clamp(_point.y, aabb.min.y, aabb.max.y));
+            if (Owns(node.index, closest, (node.flags & EdgeX) != 0, (node.flags & EdgeY) != 0))
+            {
+              _heap.Push(item, _distance(item));
+            }
+          }
+        }
+        else
+        {
+          for (size_t y = 0; y < DivY; ++y)
+          {
+            for (size_t x = 0; x < DivX; ++x)
+            {
+              NodeIndex child = current.children[y * DivX + x];
+              int flags = (x == DivX - 1 ? node.flags & EdgeX : 0) |
+                          (y == DivY - 1 ? node.flags & EdgeY : 0);
+              _heap.PushNode(child, m_nodes[child].rect.Distance(_point), flags);
+            }
+          }
+        }
+      }
+    }
+
    private:
+     static const int EdgeX = 1; //!< Flag for nodes on the maximum x edge of the tree.
+     static const int EdgeY = 2; //!< Flag for nodes on the maximum y edge of the tree.
+
+     /**
+      * \brief Cast a ray through a node the ray has entered.
+      * \param [in]      _node        Node to search.
+      * \param [in]      _ray         Ray to cast.
+      * \param [in, out] _maxDistance Distance of the closest hit.
+      * \param [in]      _callback    Function to test items.
+      */
+     template <class Callback>
+     void Raycast(NodeIndex _node, const Ray& _ray, float& _maxDistance, Callback& _callback) const
+     {
+       if (m_nodes[_node].IsLeaf())
+       {
+         for (size_t i = 0; i < m_nodes[_node].items.size(); ++i)
+         {
+           T* item = m_nodes[_node].items[i];
+           float distance;
+           if (_ray.Intersects(item->GetAABB(), _maxDistance, distance))
+           {
+             _maxDistance = Min(_maxDistance, _callback(item, _maxDistance));
+           }
+         }
+         return;
+       }
+
+       //sort the children the ray enters by distance.
+       std::array<std::pair<float, NodeIndex>, DivX * DivY> order;
+       size_t count = 0;
+
+       for (size_t i = 0; i < m_nodes[_node].children.size(); ++i)
+       {
+         NodeIndex child = m_nodes[_node].children[i];
+         float distance;
+         if (_ray.Intersects(m_nodes[child].rect, _maxDistance, distance))
+         {
+           size_t j = count++;
+           for (; j > 0 && order[j - 1].first > distance; --j)
+           {
+             order[j] = order[j - 1];
+           }
+           order[j] = std::make_pair(distance, child);
+         }
+       }
+
+       //stop once the children are further than the closest hit.
+       for (size_t i = 0; i < count && order[i].first <= _maxDistance; ++i)
+       {
+         Raycast(order[i].second, _ray, _maxDistance, _callback);
+       }
+     }
+
+     /**
+      * \brief Cast a packet of rays through a node.
+      * \param [in]      _node     Node to search.
+      * \param [in, out] _packet   Rays to cast.
+      * \param [in]      _mask     Rays that have entered the node.
+      * \param [in]      _callback Function to test items.
+      */
+     template <class Callback>
+     void Raycast(NodeIndex _node, RayPacket& _packet, int _mask, Callback& _callback) const
+     {
+       float distance[RayPacket::Size];
+
+       if (m_nodes[_node].IsLeaf())
+       {
+         for (size_t i = 0; i < m_nodes[_node].items.size(); ++i)
+         {
+           T* item = m_nodes[_node].items[i];
+           int mask = _packet.Intersects(item->GetAABB(), distance) & _mask;
+
+           for (size_t j = 0; mask != 0 && j < RayPacket::Size; ++j)
+           {
+             if (mask & (1 << j))
+             {
+               _packet.maxDistance[j] = Min(_packet.maxDistance[j], _callback(item, j, _packet.maxDistance[j]));
+             }
+           }
+         }
+         return;
+       }
+
+       struct Child
+       {
+         NodeIndex node;
+         int mask;
+         float nearest;
+         float distance[RayPacket::Size];
+       };
+
+       //sort the children the rays enter by the closest ray.
+       std::array<Child, DivX * DivY> order;
+       size_t count = 0;
+
+       for (size_t i = 0; i < m_nodes[_node].children.size(); ++i)
+       {
+         Child child;
+         child.node = m_nodes[_node].children[i];
+         child.mask = _packet.Intersects(m_nodes[child.node].rect, child.distance) & _mask;
+         if (child.mask == 0) { continue; }
+         child.nearest = RayPacket::Nearest(child.distance, child.mask);
+
+         size_t j = count++;
+         for (; j > 0 && order[j - 1].nearest > child.nearest; --j)
+         {
+           order[j] = order[j - 1];
+         }
+         order[j] = child;
+       }
+
+       for (size_t i = 0; i < count; ++i)
+       {
+         //skip the rays that have hit something before the child.
+         int mask = _packet.Cull(order[i].distance, order[i].mask);
+         if (mask != 0)
+         {
+           Raycast(order[i].node, _packet, mask, _callback);
+         }
+       }
+     }
+
+     /**
+      * \brief Find the items in a node overlapping an area.
+      * \param [in] _node     Node to search.
+      * \param [in] _rect     Area to search.
+      * \param [in] _edgeX    Is the node on the maximum x edge of the tree?
+      * \param [in] _edgeY    Is the node on the maximum y edge of the tree?
+      * \param [in] _callback Function called with each item found.
+      */
+     template <class Callback>
+     void Query(NodeIndex _node, const Rect& _rect, bool _edgeX, bool _edgeY, Callback& _callback) const
+     {
+       //if the area is outside of the node, none of the items can overlap it.
+       if (!Rect::Intersects(m_nodes[_node].rect, _rect)) { return; }
+
+       if (m_nodes[_node].IsLeaf())
+       {
+         for (size_t i = 0; i < m_nodes[_node].items.size(); ++i)
+         {
+           T* item = m_nodes[_node].items[i];
+           const Rect& aabb = item->GetAABB();
+
+           if (!Rect::Intersects(aabb, _rect)) { continue; }
+
+           //items can be in several leaves. only report the item from the
+           //leaf that holds the minimum corner of the overlap.
+           Vector2 corner(Max(aabb.min.x, _rect.min.x), Max(aabb.min.y, _rect.min.y));
+           if (Owns(_node, corner, _edgeX, _edgeY))
+           {
+             _callback(item);
+           }
+         }
+       }
+       else
+       {
+         for (size_t y = 0; y < DivY; ++y)
+         {
+           for (size_t x = 0; x < DivX; ++x)
+           {
+             Query(m_nodes[_node].children[y * DivX + x], _rect,
+               _edgeX && x == DivX - 1, _edgeY && y == DivY - 1,
+               _callback
+             );
+           }
+         }
+       }
+     }
+
+     /**
+      * \brief Check if a leaf is the one node that holds a point.
+      * Leaves share their edges, so the maximum edge only belongs
+      * to the leaf when it is also the edge of the tree.
+      * \param [in] _node  Leaf to check.
+      * \param [in] _point Position to check.
+      * \param [in] _edgeX Is the node on the maximum x edge of the tree?
+      * \param [in] _edgeY Is the node on the maximum y edge of the tree?
+      * \return Returns true if the leaf holds the point.
+      */
+     bool Owns(NodeIndex _node, Vector2 _point, bool _edgeX, bool _edgeY) const
+     {
+       //items past the edge of the tree are held by the leaves on the edge.
+       const Rect& root = m_nodes[m_root].rect;
+       _point.x = Clamp(_point.x, root.min.x, root.max.x);
+       _point.y = Clamp(_point.y, root.min.y, root.max.y);
+
+       const Rect& rect = m_nodes[_node].rect;
+       return _point.x >= rect.min.x && (_point.x < rect.max.x || _edgeX) &&
+              _point.y >= rect.min.y && (_point.y < rect.max.y || _edgeY);
+     }
+
      /**
       * \brief Insert an item into a node.
       * If the node is a leaf, add the item to the node.
@@ -113,6 +421,35 @@ namespace QuadTree
        }
      }
 
+     /**
+      * \brief Add an item to the leaves of a node it reaches, skipping the leaves that hold it.
+      * \param [in] _node Node to insert into.
+      * \param [in] _item Item to add.
+      */
+     void GrowInto(NodeIndex _node, T* _item)
+     {
+       if (!Rect::Intersects(m_nodes[_node].rect, _item->GetAABB()))
+       {
+         return;
+       }
+
+       if (m_nodes[_node].IsLeaf())
+       {
+         const auto& items = m_nodes[_node].items;
+         if (std::find(items.begin(), items.end(), _item) == items.end())
+         {
+           InsertInto(_node, _item);
+         }
+       }
+       else
+       {
+         for (size_t i = 0; i < m_nodes[_node].children.size(); ++i)
+         {
+           GrowInto(m_nodes[_node].children[i], _item);
+         }
+       }
+     }
+
      /**
       * \brief Get the pairs of items that could potentially overlap. 
       * \param [in]  _node  Node to get pairs from.
@@ -127,18 +464,24 @@ namespace QuadTree
          //needed to prevent use of -1 on size_t (unsigned int)
          if (m_nodes[_node].items.empty()) { return; }
 
+         const auto& items = m_nodes[_node].items;
+
+         //copy the bounds next to each other so they can be checked in a batch.
+         m_rects.resize(items.size());
+         m_hits.resize(items.size());
+         for (size_t i = 0; i < items.size(); ++i)
+         {
+           m_rects[i] = items[i]->GetAABB();
+         }
+
          //compare all combinations of items.
-         for (size_t i = 0; i < m_nodes[_node].items.size() - 1; ++i)
+         for (size_t i = 0; i < items.size() - 1; ++i)
          {
-           T* a = m_nodes[_node].items[i];
-           for (size_t j = i + 1; j < m_nodes[_node].items.size(); ++j)
+           //find the later items that overlap a.
+           size_t count = Rect::Intersects(m_rects[i], &m_rects[i + 1], items.size() - i - 1, m_hits.data());
+           for (size_t j = 0; j < count; ++j)
            {
-             T* b = m_nodes[_node].items[j];
-             //if the two items overlap, add them to the pair list.
-             if (Rect::Intersects(a->GetAABB(), b->GetAABB()))
-             {
-               _pairs.push_back({ a, b });
-             }
+             _pairs.push_back({ items[i], items[i + 1 + m_hits[j]] });
            }
          }
        }
@@ -222,30 +565,53 @@ namespace QuadTree
      }
 
      /**
-      * \brief Draw the node's area.
-      * If the node is a leaf, draw its children.
-      * Else draw the child nodes.
-      * \param [in]      _node     Node to draw.
-      * \param [in, out] _renderer Renderer to draw to.
+      * \brief Add the node's area to draw.
+      * If the node is a leaf, add its items.
+      * Else add the child nodes.
+      * \param [in]      _node  Node to draw.
+      * \param [in, out] _debug Culls and stores the rects.
+      * \param [in]      _edgeX Is the node on the maximum x edge of the tree?
+      * \param [in]      _edgeY Is the node on the maximum y edge of the tree?
       */
-     void Draw(NodeIndex _node, Renderer& _renderer) const
+     void Draw(NodeIndex _node, DebugDraw& _debug, bool _edgeX, bool _edgeY) const
      {
-       m_nodes[_node].rect.Draw(_renderer);
+       const NodeType& node = m_nodes[_node];
 
-       //if it is a leaf, draw the items.
-       if (m_nodes[_node].IsLeaf())
+       //nothing inside a node out of view can be seen.
+       if (!_debug.Visible(node.rect)) { return; }
+
+       bool show = _debug.ShowNode(node.rect, node.depth);
+       if (show) { _debug.AddRect(node.rect); }
+
+       if (node.IsLeaf())
        {
-         for (size_t i = 0; i < m_nodes[_node].items.size(); ++i)
+         const Rect& view = _debug.GetView();
+         for (size_t i = 0; i < node.items.size(); ++i)
          {
-           m_nodes[_node].items[i]->DrawRect(_renderer);
+           const Rect& aabb = node.items[i]->GetAABB();
+           if (!_debug.ShowItem(aabb)) { continue; }
+
+           //items can be in several leaves. only draw the item from the
+           //leaf that holds the minimum corner of its visible part.
+           Vector2 corner(Max(aabb.min.x, view.min.x), Max(aabb.min.y, view.min.y));
+           if (Owns(_node, corner, _edgeX, _edgeY))
+           {
+             _debug.AddRect(aabb);
+           }
          }
        }
-       //if it is not leaf, draw the children.
-       else
+       //the children are deeper and smaller, so they are
+       //only needed for the items once this node is hidden.
+       else if (show || _debug.GetSettings().items)
        {
-         for (size_t i = 0; i < m_nodes[_node].children.size(); ++i)
+         for (size_t y = 0; y < DivY; ++y)
          {
-           Draw(m_nodes[_node].children[i], _renderer);
+           for (size_t x = 0; x < DivX; ++x)
+           {
+             Draw(node.children[y * DivX + x], _debug,
+               _edgeX && x == DivX - 1, _edgeY && y == DivY - 1
+             );
+           }
          }
        }
      }
@@ -336,6 +702,9 @@ namespace QuadTree
 
     size_t m_maxItems; //!< Maximum items in a bucket, if a bucket passes this value, the node is subdivided.
     int m_maxDepth; //!< Maximum level of nodes.
+
+    std::vector<Rect> m_rects; //!< Bounds of the items in a leaf, reused when getting pairs.
+    std::vector<size_t> m_hits; //!< Overlapping items in a leaf, reused when getting pairs.
    };
 }
 
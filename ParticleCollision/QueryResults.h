@@ -0,0 +1,46 @@
+#ifndef _QUERYRESULTS_H_
+#define _QUERYRESULTS_H_
+
+#include <vector>
+
+class Collider;
+
+using ColliderList = std::vector<Collider*>; //!< List of colliders found by a query.
+
+/**
+ * \brief Store the results of a batch of queries.
+ * The colliders of every query are packed into one list, query i
+ * owns the items from offsets[i] to offsets[i + 1]. Keep the object
+ * between frames so the storage is reused.
+ */
+
+struct QueryResults
+{
+ public:
+  void Clear()
+  {
+    items.clear();
+    offsets.clear();
+    offsets.push_back(0u);
+  } //!< Remove all results, keeping the storage.
+
+  size_t Count() const
+  {
+    return offsets.empty() ? 0u : offsets.size() - 1u;
+  } //!< Get the number of queries.
+
+  size_t Begin(size_t _query) const
+  {
+    return offsets[_query];
+  } //!< Get the index of the first item of a query.
+
+  size_t End(size_t _query) const
+  {
+    return offsets[_query + 1u];
+  } //!< Get the index after the last item of a query.
+
+  ColliderList items; //!< Colliders found by all the queries.
+  std::vector<size_t> offsets; //!< Start of each query's items.
+};
+
+#endif //_QUERYRESULTS_H_
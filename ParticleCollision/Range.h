@@ -12,21 +12,37 @@ class Range
  public:
   float min, max;
 
-	Range(); //!< Default constructor.
-	Range(float _min, float _max); //!< Constructor.
-
-  void Sort(); //!< Sort the values so min will be the smaller value and max will be the higher value.
-
-  bool Contains(float _x) const; //!< Is the point within the range.
-	float Distance(float _x) const; //!< How far is the point from the range.
-
-  bool Overlaps(const Range& _other) const; //!< Do the ranges overlap.
-  float Overlap(const Range& _other) const; //!< Get the amount of overlap between this and the other range.
-  float Distance(const Range& _other) const; //!< Get the distance between this and the other range.
-
-  static bool Overlaps(const Range& _a, const Range& _b); //!< Do the ranges overlap.
-  static float Overlap(const Range& _a, const Range& _b); //!< Get the amount of overlap between two ranges.
-  static float Distance(const Range& _a, const Range& _b); //!< Get the distance between two ranges.
+	constexpr Range() : min(.0f), max(.0f) { } //!< Default constructor.
+	constexpr Range(float _min, float _max) : min(_min), max(_max) { } //!< Constructor.
+
+  void Sort()
+  {
+    float tmp = min;
+    min = Min(tmp, max);
+    max = Max(tmp, max);
+  } //!< Sort the values so min will be the smaller value and max will be the higher value.
+
+  constexpr bool Contains(float _x) const { return (_x >= min) & (_x <= max); } //!< Is the point within the range.
+	constexpr float Distance(float _x) const { return Contains(_x) ? .0f : Min(Abs(min - _x), Abs(_x - max)); } //!< How far is the point from the range.
+
+  constexpr bool Overlaps(const Range& _other) const { return Overlaps(*this, _other); } //!< Do the ranges overlap.
+  constexpr float Overlap(const Range& _other) const { return Overlap(*this, _other); } //!< Get the amount of overlap between this and the other range.
+  constexpr float Distance(const Range& _other) const { return Distance(*this, _other); } //!< Get the distance between this and the other range.
+
+  static constexpr bool Overlaps(const Range& _a, const Range& _b)
+  {
+    return (_a.min <= _b.max) & (_a.max >= _b.min);
+  } //!< Do the ranges overlap.
+
+  static constexpr float Overlap(const Range& _a, const Range& _b)
+  {
+    return Max(0.0f, Min(_a.max, _b.max) - Max(_a.min, _b.min));
+  } //!< Get the amount of overlap between two ranges.
+
+  static constexpr float Distance(const Range& _a, const Range& _b)
+  {
+    return Overlaps(_a, _b) ? .0f : Min(Abs(_a.min - _b.max), Abs(_b.min - _a.max));
+  } //!< Get the distance between two ranges.
 };
 
-#endif //_RANGE_H_
\ No newline at end of file
+#endif //_RANGE_H_
@@ -0,0 +1,39 @@
+#include "Ray.h"
+
+Ray::Ray() :
+  length(.0f), radius(.0f)
+{ }
+
+Ray::Ray(const Vector2& _origin, const Vector2& _direction, float _length, float _radius) :
+  origin(_origin), direction(_direction),
+  length(_length), radius(_radius)
+{ }
+
+Vector2 Ray::GetPoint(float _distance) const
+{
+  return origin + direction * _distance;
+}
+
+bool Ray::Intersects(const Rect& _rect, float _maxDistance, float& _distance) const
+{
+  float invX = Inverse(direction.x);
+  float invY = Inverse(direction.y);
+
+  //get the distances to the sides of the rect on each axis.
+  float x1 = (_rect.min.x - radius - origin.x) * invX;
+  float x2 = (_rect.max.x + radius - origin.x) * invX;
+  float y1 = (_rect.min.y - radius - origin.y) * invY;
+  float y2 = (_rect.max.y + radius - origin.y) * invY;
+
+  //the ray is inside the rect between the last entry and the first exit.
+  float entry = Max(Max(Min(x1, x2), Min(y1, y2)), 0.f);
+  float exit = Min(Max(x1, x2), Max(y1, y2));
+
+  _distance = entry;
+  return entry <= exit && entry <= _maxDistance;
+}
+
+float Ray::Inverse(float _x)
+{
+  return _x == .0f ? 1e30f : 1.f / _x;
+}
@@ -0,0 +1,66 @@
+#ifndef _RAY_H_
+#define _RAY_H_
+
+#include "Rect.h"
+
+class Collider;
+
+/**
+ * \brief Define a ray.
+ * A ray with a radius sweeps a circle along its direction.
+ */
+
+class Ray
+{
+ public:
+  Vector2 origin; //!< Start position.
+  Vector2 direction; //!< Direction of the ray. Must be unit length.
+  float length; //!< Distance to check along the ray.
+  float radius; //!< Size of the swept circle, 0 for a thin ray.
+
+  Ray(); //!< Default constructor.
+  /**
+   * \brief Constructor.
+   * \param [in] _origin    Start position.
+   * \param [in] _direction Unit direction.
+   * \param [in] _length    Distance to check.
+   * \param [in] _radius    Size of the swept circle.
+   */
+  Ray(const Vector2& _origin, const Vector2& _direction, float _length, float _radius = 0.f);
+
+  Vector2 GetPoint(float _distance) const; //!< Get the position at a distance along the ray.
+
+  /**
+   * \brief Check if the ray passes through a rectangle.
+   * The rectangle is grown by the radius of the ray.
+   * \param [in]  _rect        Rect to check.
+   * \param [in]  _maxDistance Distance to stop checking at.
+   * \param [out] _distance    Distance where the ray enters the rectangle.
+   * \return Returns true if the ray hits the rectangle.
+   */
+  bool Intersects(const Rect& _rect, float _maxDistance, float& _distance) const;
+
+  /**
+   * \brief Get the inverse of a direction component for slab tests.
+   * Axis aligned directions use a large value instead of infinity so
+   * the slab test does not produce NaNs.
+   * \param [in] _x Direction component.
+   * \return Returns one over the component.
+   */
+  static float Inverse(float _x);
+};
+
+/**
+ * \brief Store information about a ray hit.
+ */
+
+struct RayHit
+{
+ public:
+  Collider *collider; //!< Collider that was hit, nullptr if nothing was hit.
+  float distance; //!< Distance along the ray to the hit.
+  Vector2 point; //!< Position of the hit on the collider.
+  Vector2 normal; //!< Surface normal of the collider at the hit.
+};
+
+#endif //_RAY_H_
@@ -0,0 +1,116 @@
+#include "RayPacket.h"
+
+#include <limits>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE__)
+  #include <xmmintrin.h>
+  #define RAYPACKET_SSE
+#endif
+
+const size_t RayPacket::Size;
+
+RayPacket::RayPacket() :
+  count(0)
+{
+  Set(nullptr, 0);
+}
+
+void RayPacket::Set(const Ray* _rays, size_t _count)
+{
+  count = _count;
+
+  for (size_t i = 0; i < Size; ++i)
+  {
+    if (i < _count)
+    {
+      originX[i] = _rays[i].origin.x;
+      originY[i] = _rays[i].origin.y;
+      inverseX[i] = Ray::Inverse(_rays[i].direction.x);
+      inverseY[i] = Ray::Inverse(_rays[i].direction.y);
+      radius[i] = _rays[i].radius;
+      maxDistance[i] = _rays[i].length;
+    }
+    //unused lanes can not hit anything before a negative distance.
+    else
+    {
+      originX[i] = originY[i] = .0f;
+      inverseX[i] = inverseY[i] = 1.f;
+      radius[i] = .0f;
+      maxDistance[i] = -1.f;
+    }
+  }
+}
+
+int RayPacket::Intersects(const Rect& _rect, float* _distance) const
+{
+#ifdef RAYPACKET_SSE
+  __m128 r = _mm_load_ps(radius);
+
+  //get the distances to the sides of the rect on each axis.
+  __m128 ox = _mm_load_ps(originX);
+  __m128 ix = _mm_load_ps(inverseX);
+  __m128 x1 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(_rect.min.x), r), ox), ix);
+  __m128 x2 = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_set1_ps(_rect.max.x), r), ox), ix);
+
+  __m128 oy = _mm_load_ps(originY);
+  __m128 iy = _mm_load_ps(inverseY);
+  __m128 y1 = _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(_rect.min.y), r), oy), iy);
+  __m128 y2 = _mm_mul_ps(_mm_sub_ps(_mm_add_ps(_mm_set1_ps(_rect.max.y), r), oy), iy);
+
+  //the rays are inside the rect between the last entry and the first exit.
+  __m128 entry = _mm_max_ps(_mm_max_ps(_mm_min_ps(x1, x2), _mm_min_ps(y1, y2)), _mm_setzero_ps());
+  __m128 exit = _mm_min_ps(_mm_max_ps(x1, x2), _mm_max_ps(y1, y2));
+
+  __m128 hit = _mm_and_ps(
+    _mm_cmple_ps(entry, exit),
+    _mm_cmple_ps(entry, _mm_load_ps(maxDistance))
+  );
+
+  _mm_storeu_ps(_distance, entry);
+  return _mm_movemask_ps(hit);
+#else
+  int mask = 0;
+  for (size_t i = 0; i < Size; ++i)
+  {
+    float x1 = (_rect.min.x - radius[i] - originX[i]) * inverseX[i];
+    float x2 = (_rect.max.x + radius[i] - originX[i]) * inverseX[i];
+    float y1 = (_rect.min.y - radius[i] - originY[i]) * inverseY[i];
+    float y2 = (_rect.max.y + radius[i] - originY[i]) * inverseY[i];
+
+    float entry = Max(Max(Min(x1, x2), Min(y1, y2)), 0.f);
+    float exit = Min(Max(x1, x2), Max(y1, y2));
+
+    _distance[i] = entry;
+    if (entry <= exit && entry <= maxDistance[i])
+    {
+      mask |= 1 << i;
+    }
+  }
+  return mask;
+#endif
+}
+
+int RayPacket::Cull(const float* _distance, int _mask) const
+{
+  for (size_t i = 0; i < Size; ++i)
+  {
+    if (_distance[i] > maxDistance[i])
+    {
+      _mask &= ~(1 << i);
+    }
+  }
+  return _mask;
+}
+
+float RayPacket::Nearest(const float* _distance, int _mask)
+{
+  float nearest = std::numeric_limits<float>().max();
+  for (size_t i = 0; i < Size; ++i)
+  {
+    if (_mask & (1 << i))
+    {
+      nearest = Min(nearest, _distance[i]);
+    }
+  }
+  return nearest;
+}
@@ -0,0 +1,61 @@
+#ifndef _RAYPACKET_H_
+#define _RAYPACKET_H_
+
+#include "Ray.h"
+
+/**
+ * \brief Group of rays tested together.
+ * Stores the rays as arrays so a rectangle can be tested
+ * against every ray in the packet at once.
+ */
+
+class RayPacket
+{
+ public:
+  static const size_t Size = 4; //!< Number of rays in a packet.
+
+  RayPacket(); //!< Constructor.
+
+  /**
+   * \brief Load rays into the packet.
+   * Unused lanes never hit anything.
+   * \param [in] _rays  First ray to load.
+   * \param [in] _count Number of rays, at most Size.
+   */
+  void Set(const Ray* _rays, size_t _count);
+
+  /**
+   * \brief Check which rays pass through a rectangle before their max distance.
+   * \param [in]  _rect     Rect to check.
+   * \param [out] _distance Distance where each ray enters the rectangle.
+   * \return Returns a bit mask of the rays that hit the rectangle.
+   */
+  int Intersects(const Rect& _rect, float* _distance) const;
+
+  /**
+   * \brief Remove rays from a mask that can no longer reach a distance.
+   * \param [in] _distance Distance for each ray.
+   * \param [in] _mask     Rays to check.
+   * \return Returns the rays whose closest hit is further than the distance.
+   */
+  int Cull(const float* _distance, int _mask) const;
+
+  /**
+   * \brief Get the smallest distance of the rays in a mask.
+   * \param [in] _distance Distance for each ray.
+   * \param [in] _mask     Rays to check.
+   * \return Returns the smallest distance.
+   */
+  static float Nearest(const float* _distance, int _mask);
+
+  alignas(16) float originX[Size]; //!< Start x positions.
+  alignas(16) float originY[Size]; //!< Start y positions.
+  alignas(16) float inverseX[Size]; //!< One over the x directions.
+  alignas(16) float inverseY[Size]; //!< One over the y directions.
+  alignas(16) float radius[Size]; //!< Sizes of the swept circles.
+  alignas(16) float maxDistance[Size]; //!< Distance to the closest hit of each ray so far.
+
+  size_t count; //!< Number of rays in use.
+};
+
+#endif //_RAYPACKET_H_
@@ -1,12 +1,17 @@
 #ifndef _RECT_H_
 #define _RECT_H_
 
+#include <cstddef>
+
 #include "Maths.h"
-#include "Renderer.h"
+#include "Kernels.h"
+
+class Renderer;
 
 /**
  * \brief Define a rectangle.
- * AABB.
+ * AABB. The four values are stored together, min then max, so a
+ * rect can be loaded into one SSE register.
  */
 
 class Rect
@@ -15,13 +20,13 @@ class Rect
   Vector2 min; //!< minimum corner of the rectangle (top left).
   Vector2 max; //!< maximum corner or the rectang;e (bottom right).
 
-  Rect(); //!< default Constructor.
+  constexpr Rect() { } //!< default Constructor.
   /**
    * \brief Constructor.
    * \param [in] _minimum Define the top left corner.
    * \param [in] _maximum Define the bottom left corner.
    */
-  Rect(const Vector2& _min, const Vector2& _max);
+  constexpr Rect(const Vector2& _min, const Vector2& _max) : min(_min), max(_max) { }
   /**
    * \brief Constructor.
    * \param [in] _minx Left.
@@ -29,42 +34,66 @@ class Rect
    * \param [in] _maxx Right.
    * \param [in] _maxy Bottom.
    */
-  Rect(float _minx, float _miny, float _maxx, float _maxy);
+  constexpr Rect(float _minx, float _miny, float _maxx, float _maxy) : min(_minx, _miny), max(_maxx, _maxy) { }
 
-  float Width()  const; //!< Get the width.
-  float Height() const; //!< Get the height.
-  Vector2 Size() const; //!< Get the width and height.
+  constexpr float Width()  const { return max.x - min.x; } //!< Get the width.
+  constexpr float Height() const { return max.y - min.y; } //!< Get the height.
+  constexpr Vector2 Size() const { return max - min; } //!< Get the width and height.
 
-  float Parimeter() const; //!< Get the parimeter.
-  float Area()      const; //!< Get the area.
+  constexpr float Parimeter() const { return (Width() + Height()) * 2.0f; } //!< Get the parimeter.
+  constexpr float Area()      const { return Width() * Height(); } //!< Get the area.
 
-  Vector2 TopLeft()     const; //!< minimum x, minimum y.
-  Vector2 TopRight()    const; //!< maximum x, minimum y.
-  Vector2 BottomLeft()  const; //!< minimim x, maximum y.
-  Vector2 BottomRight() const; //!< maximum x, maximum y.
+  constexpr Vector2 TopLeft()     const { return min; } //!< minimum x, minimum y.
+  constexpr Vector2 TopRight()    const { return Vector2(max.x, min.y); } //!< maximum x, minimum y.
+  constexpr Vector2 BottomLeft()  const { return Vector2(min.x, max.y); } //!< minimim x, maximum y.
+  constexpr Vector2 BottomRight() const { return max; } //!< maximum x, maximum y.
 
   /**
    * \brief Checks if the point is within the rectangle.
    * \param [in] _point The point to query.
    * \return Returns true if the the point is inside the rectangle.
    */
-  bool Contains(const Vector2& _point) const;
+  constexpr bool Contains(const Vector2& _point) const
+  {
+    return (_point.x >= min.x) & (_point.x <= max.x) &
+           (_point.y >= min.y) & (_point.y <= max.y);
+  }
 
   /**
    * \brief Checks if the rectangle is fully contained.
    * \param [in] _rect Rect to query.
    * \return Returns true if the rectangle is contained within this Rectangle.
    */
-  bool Contains(const Rect& _rect) const;
+  constexpr bool Contains(const Rect& _rect) const
+  {
+    return Contains(_rect.min) & Contains(_rect.max);
+  }
 
   /**
    * \brief Checks if the rectangle overlaps this.
    * \param [in] _rect Rect to query.
    * \return Returns true if the rectangles overlap.
    */
-  bool Intersects(const Rect& _rect) const;
+  constexpr bool Intersects(const Rect& _rect) const
+  {
+    //use & so all four compares are done without branching.
+    return (min.x <= _rect.max.x) & (max.x >= _rect.min.x) &
+           (min.y <= _rect.max.y) & (max.y >= _rect.min.y);
+  }
+
+  /**
+   * \brief Get the distance from a point to the rectangle.
+   * \param [in] _point The point to query.
+   * \return Returns the distance, 0 if the point is inside.
+   */
+  float Distance(const Vector2& _point) const
+  {
+    float x = Max(Max(min.x - _point.x, _point.x - max.x), 0.f);
+    float y = Max(Max(min.y - _point.y, _point.y - max.y), 0.f);
+    return std::sqrt(x * x + y * y);
+  }
 
-  /** 
+  /**
    * \brief Draws the rectangle.
    * \param [in] _renderer Renderer to draw to.
    */
@@ -76,15 +105,44 @@ class Rect
    * \param [in] _b
    * \return Returns true if the rectangles overlap.
    */
-  static bool Intersects(const Rect& _a, const Rect& _b);
+  static constexpr bool Intersects(const Rect& _a, const Rect& _b)
+  {
+    return _a.Intersects(_b);
+  }
+
+  /**
+   * \brief Find the rects that overlap a rect.
+   * \param [in]  _rect    Rect to check against.
+   * \param [in]  _rects   First rect to check.
+   * \param [in]  _count   Number of rects to check.
+   * \param [out] _indices Set to the index of each rect that overlaps, in order.
+   *                       Must have room for _count indices.
+   * \return Returns the number of rects that overlap.
+   */
+  static size_t Intersects(const Rect& _rect, const Rect* _rects, size_t _count, size_t* _indices)
+  {
+    //uses the widest instruction set the processor has.
+    return Kernels::Get().intersects(_rect, _rects, _count, _indices);
+  }
 
   /**
    * \brief Creates a rectangle that encompases both.
    * \param [in] _a
    * \param [in] _b
-   * \return Returns the new rectangle. 
+   * \return Returns the new rectangle.
    */
-  static Rect Union(const Rect& _a, const Rect& _b);
+  static constexpr Rect Union(const Rect& _a, const Rect& _b)
+  {
+    return Rect(
+      Min(_a.min.x, _b.min.x),
+      Min(_a.min.y, _b.min.y),
+
+      Max(_a.max.x, _b.max.x),
+      Max(_a.max.y, _b.max.y)
+    );
+  }
 };
 
-#endif //_RECT_H_
\ No newline at end of file
+static_assert(sizeof(Rect) == sizeof(float) * 4, "Rect must be four packed floats.");
+
+#endif //_RECT_H_
@@ -0,0 +1,164 @@
+#include "RenderBatch.h"
+
+#include <cstdlib>
+
+RenderBatch::RenderBatch()
+{
+  SetClip(0, 0);
+}
+
+RenderBatch::~RenderBatch()
+{ }
+
+void RenderBatch::SetClip(int _width, int _height)
+{
+  m_clip.x = m_clip.y = 0;
+  m_clip.w = _width;
+  m_clip.h = _height;
+}
+
+void RenderBatch::AddPoint(int _x, int _y)
+{
+  m_points.push_back({ _x, _y });
+}
+
+void RenderBatch::AddLine(int _x1, int _y1, int _x2, int _y2)
+{
+  //only rasterize the part of the line that is on screen.
+  if (m_clip.w > 0 && m_clip.h > 0 &&
+      SDL_IntersectRectAndLine(&m_clip, &_x1, &_y1, &_x2, &_y2) == SDL_FALSE)
+  {
+    return;
+  }
+
+  //Bresenham's line algorithm.
+  int dx = std::abs(_x2 - _x1), sx = _x1 < _x2 ? 1 : -1;
+  int dy = -std::abs(_y2 - _y1), sy = _y1 < _y2 ? 1 : -1;
+  int err = dx + dy;
+
+  while (true)
+  {
+    m_points.push_back({ _x1, _y1 });
+
+    if (_x1 == _x2 && _y1 == _y2) { break; }
+
+    int err2 = err * 2;
+    if (err2 >= dy)
+    {
+      err += dy;
+      _x1 += sx;
+    }
+    if (err2 <= dx)
+    {
+      err += dx;
+      _y1 += sy;
+    }
+  }
+}
+
+void RenderBatch::AddCircle(int _x, int _y, int _radius)
+{
+  //skip circles that are completely off screen.
+  if (m_clip.w > 0 && m_clip.h > 0 &&
+      (_x + _radius < 0 || _x - _radius >= m_clip.w ||
+       _y + _radius < 0 || _y - _radius >= m_clip.h))
+  {
+    return;
+  }
+
+  const std::vector<SDL_Point>& circle = GetCircle(_radius);
+
+  //move the outline to the circle's position.
+  size_t start = m_points.size();
+  m_points.resize(start + circle.size());
+
+  for (size_t i = 0; i < circle.size(); ++i)
+  {
+    m_points[start + i].x = circle[i].x + _x;
+    m_points[start + i].y = circle[i].y + _y;
+  }
+}
+
+void RenderBatch::AddRect(const SDL_Rect& _rect)
+{
+  m_rects.push_back(_rect);
+}
+
+void RenderBatch::Flush(SDL_Renderer* _renderer)
+{
+  if (!m_rects.empty())
+  {
+    SDL_RenderDrawRects(_renderer, &m_rects[0], static_cast<int>(m_rects.size()));
+  }
+  if (!m_points.empty())
+  {
+    SDL_RenderDrawPoints(_renderer, &m_points[0], static_cast<int>(m_points.size()));
+  }
+
+  Clear();
+}
+
+void RenderBatch::Clear()
+{
+  m_points.clear();
+  m_rects.clear();
+}
+
+bool RenderBatch::Empty() const
+{
+  return m_points.empty() && m_rects.empty();
+}
+
+const std::vector<SDL_Point>& RenderBatch::GetCircle(int _radius)
+{
+  if (_radius < 0) { _radius = 0; }
+
+  if (static_cast<size_t>(_radius) >= m_circles.size())
+  {
+    m_circles.resize(_radius + 1);
+  }
+
+  std::vector<SDL_Point>& points = m_circles[_radius];
+
+  //the outline has already been made.
+  if (!points.empty()) { return points; }
+
+  //a circle too small for the outline is a single pixel.
+  if (_radius <= 1)
+  {
+    points.push_back({ 0, 0 });
+    return points;
+  }
+
+  //midpoint circle algorithm.
+  int x = _radius - 1, y = 0;
+  int dx = 1, dy = 1;
+  int err = dx - (_radius << 1);
+
+  while (x >= y)
+  {
+    points.push_back({  x,  y });
+    points.push_back({  y,  x });
+    points.push_back({ -y,  x });
+    points.push_back({ -x,  y });
+    points.push_back({ -x, -y });
+    points.push_back({ -y, -x });
+    points.push_back({  y, -x });
+    points.push_back({  x, -y });
+
+    if (err <= 0)
+    {
+      ++y;
+      err += dy;
+      dy += 2;
+    }
+    if (err > 0)
+    {
+      --x;
+      dx += 2;
+      err += dx - (_radius << 1);
+    }
+  }
+
+  return points;
+}
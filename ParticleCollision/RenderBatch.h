@@ -0,0 +1,76 @@
+#ifndef _RENDERBATCH_H_
+#define _RENDERBATCH_H_
+
+#include <vector>
+
+#include "SDL.h"
+
+/**
+ * \brief Collect primitives to draw them in as few calls as possible.
+ * Circles and lines are stored as points and submitted with one
+ * SDL_RenderDrawPoints call, rectangles with one SDL_RenderDrawRects
+ * call. The storage is kept between frames.
+ */
+
+class RenderBatch
+{
+ public:
+  RenderBatch(); //!< Constructor.
+  ~RenderBatch(); //!< Destructor.
+
+  /**
+   * \brief Set the area primitives are clipped to.
+   * \param [in] _width  Width of the output in pixels.
+   * \param [in] _height Height of the output in pixels.
+   */
+  void SetClip(int _width, int _height);
+
+  void AddPoint(int _x, int _y); //!< Add a single pixel.
+
+  /**
+   * \brief Add a line.
+   * \param [in] _x1 Start x position.
+   * \param [in] _y1 Start y position.
+   * \param [in] _x2 End x position.
+   * \param [in] _y2 End y position.
+   */
+  void AddLine(int _x1, int _y1, int _x2, int _y2);
+
+  /**
+   * \brief Add a circle outline.
+   * \param [in] _x      Centre x position.
+   * \param [in] _y      Centre y position.
+   * \param [in] _radius Size.
+   */
+  void AddCircle(int _x, int _y, int _radius);
+
+  void AddRect(const SDL_Rect& _rect); //!< Add a rectangle outline.
+
+  /**
+   * \brief Draw everything in the batch and empty it.
+   * \param [in, out] _renderer Renderer to draw to.
+   */
+  void Flush(SDL_Renderer* _renderer);
+
+  void Clear(); //!< Empty the batch, keeping the storage.
+
+  bool Empty() const; //!< Is there anything to draw?
+
+ private:
+  /**
+   * \brief Get the points of a circle outline around the origin.
+   * The points are only generated the first time a radius is used.
+   * \param [in] _radius Size of the circle.
+   * \return Returns the points of the outline.
+   */
+  const std::vector<SDL_Point>& GetCircle(int _radius);
+
+  std::vector<SDL_Point> m_points; //!< Points to draw.
+  std::vector<SDL_Rect> m_rects; //!< Rectangles to draw.
+
+  std::vector<std::vector<SDL_Point>> m_circles; //!< Circle outlines for each radius.
+
+  SDL_Rect m_clip; //!< Area of the output.
+};
+
+#endif //_RENDERBATCH_H_
@@ -1,9 +1,13 @@
 #include "Renderer.h"
 
 #include "Window.h"
+#include "ThreadPool.h"
 
 Renderer::Renderer() :
-  m_renderer(nullptr)
+  m_renderer(nullptr),
+  m_scale(1.f),
+  m_spritesEnabled(QuadBatch::IsBatched()),
+  m_pool(nullptr)
 {
   //Start with the render clear colour as black.
   SetClearColour(0, 0, 0);
@@ -31,30 +35,86 @@ bool Renderer::Create(const Window& _window)
   return m_renderer != nullptr;
 }
 
+bool Renderer::CreateHeadless(int _width, int _height, ThreadPool& _pool)
+{
+  Destroy();
+
+  m_software.Resize(_width, _height);
+  m_pool = &_pool;
+
+  return m_software.GetWidth() > 0 && m_software.GetHeight() > 0;
+}
+
 void Renderer::Destroy()
 {
   //if a renderer exists, destroy it
   if (m_renderer != nullptr)
   {
+    //the textures belong to the renderer.
+    m_sprites.Destroy();
+    m_frame.Destroy();
     SDL_DestroyRenderer(m_renderer);
     m_renderer = nullptr;
   }
+  m_pool = nullptr;
 }
 
 void Renderer::Clear()
 {
+  int width, height;
+  GetOutputSize(width, height);
+
+  if (m_renderer == nullptr)
+  {
+    //without a window the framebuffer is the output.
+    m_software.Clear(
+      0xFF000000 | (m_clearColour.r << 16) | (m_clearColour.g << 8) | m_clearColour.b
+    );
+    return;
+  }
+
   //set the draw colour to the clear colour
   SetRenderColour(m_clearColour.r, m_clearColour.g, m_clearColour.b);
   //clear the renderer in the clear colour.
   SDL_RenderClear(m_renderer);
+
+  //clip the batch to the size of the output.
+  m_batch.SetClip(width, height);
+  m_sprites.SetClip(width, height);
+  m_software.Resize(width, height);
 }
 
 void Renderer::Render()
 {
+  Flush();
+
+  if (m_renderer == nullptr) { return; }
+
   //draw the renderer to the screen.
   SDL_RenderPresent(m_renderer);
 }
 
+void Renderer::Flush()
+{
+  if (m_pool != nullptr)
+  {
+    FlushSoftware();
+  }
+  m_batch.Flush(m_renderer);
+  m_sprites.Flush(m_renderer);
+}
+
+void Renderer::GetOutputSize(int& _width, int& _height) const
+{
+  if (m_renderer == nullptr)
+  {
+    _width = m_software.GetWidth();
+    _height = m_software.GetHeight();
+    return;
+  }
+  SDL_GetRendererOutputSize(m_renderer, &_width, &_height);
+}
+
 void Renderer::SetClearColour(Uint8 _r, Uint8 _g, Uint8 _b)
 {
   //assign the colour
@@ -63,8 +123,121 @@ void Renderer::SetClearColour(Uint8 _r, Uint8 _g, Uint8 _b)
 
 void Renderer::SetRenderColour(Uint8 _r, Uint8 _g, Uint8 _b, Uint8 _a)
 {
+  //draw everything batched in the previous colour.
+  //the software primitives keep their own colour.
+  m_batch.Flush(m_renderer);
+  m_sprites.Flush(m_renderer);
   //set the draw colour of the renderer.
-  SDL_SetRenderDrawColor(m_renderer, _r, _g, _b, _a);
+  if (m_renderer != nullptr)
+  {
+    SDL_SetRenderDrawColor(m_renderer, _r, _g, _b, _a);
+  }
+  m_software.SetColour(_r, _g, _b, _a);
+  //tint the sprites the same colour.
+  m_sprites.SetColour({ _r, _g, _b, _a });
+}
+
+void Renderer::SetView(const Vector2& _offset, float _scale)
+{
+  m_offset = _offset;
+  m_scale = _scale;
+}
+
+Vector2 Renderer::ToScreen(const Vector2& _point) const
+{
+  return (_point - m_offset) * m_scale;
+}
+
+float Renderer::ToScreen(float _length) const
+{
+  return _length * m_scale;
+}
+
+const Vector2& Renderer::GetOffset() const
+{
+  return m_offset;
+}
+
+float Renderer::GetScale() const
+{
+  return m_scale;
+}
+
+RenderBatch& Renderer::GetBatch()
+{
+  return m_batch;
+}
+
+bool Renderer::LoadSprites(const std::string& _filename)
+{
+  return m_sprites.Create(*this, _filename);
+}
+
+void Renderer::SetSprites(bool _enabled)
+{
+  m_spritesEnabled = _enabled;
+}
+
+bool Renderer::GetSpritesEnabled() const
+{
+  return m_spritesEnabled;
+}
+
+SpriteBatch* Renderer::GetSprites()
+{
+  //the software renderer draws the outlines.
+  if (m_pool != nullptr) { return nullptr; }
+  return m_spritesEnabled && m_sprites.IsCreated() ? &m_sprites : nullptr;
+}
+
+void Renderer::SetSoftware(ThreadPool* _pool)
+{
+  //a headless renderer can only draw in software.
+  if (m_renderer == nullptr) { return; }
+
+  Flush();
+  m_pool = _pool;
+}
+
+SoftwareRenderer* Renderer::GetSoftware()
+{
+  return m_pool != nullptr ? &m_software : nullptr;
+}
+
+bool Renderer::SaveFrame(const std::string& _filename) const
+{
+  return m_software.SaveBMP(_filename);
+}
+
+void Renderer::FlushSoftware()
+{
+  //without a window keep drawing into the framebuffer.
+  if (m_renderer == nullptr)
+  {
+    m_software.Rasterize(*m_pool);
+    return;
+  }
+
+  if (m_software.Empty()) { return; }
+
+  //draw a transparent layer over what the renderer already has.
+  m_software.Clear(0u);
+  m_software.Rasterize(*m_pool);
+
+  int width = m_software.GetWidth(), height = m_software.GetHeight();
+  if (m_frame.GetWidth() != width || m_frame.GetHeight() != height)
+  {
+    if (!m_frame.Create(*this, width, height, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING))
+    {
+      printf("Unable to create the software frame. SDL Error: %s\n", SDL_GetError());
+      return;
+    }
+    SDL_SetTextureBlendMode(m_frame.Get(), SDL_BLENDMODE_BLEND);
+  }
+
+  //upload the whole framebuffer in one go.
+  m_frame.Update(m_software.GetPixels(), m_software.GetPitch());
+  SDL_RenderCopy(m_renderer, m_frame.Get(), nullptr, nullptr);
 }
 
 SDL_Renderer* Renderer::Get() const
@@ -3,7 +3,13 @@
 
 #include "SDL.h"
 
+#include "Vector2.h"
+#include "RenderBatch.h"
+#include "SpriteBatch.h"
+#include "SoftwareRenderer.h"
+
 class Window;
+class ThreadPool;
 
 /**
  * \brief Container class for a renderer.
@@ -26,10 +32,29 @@ class Renderer
    */
   bool Create(const Window& _window);
 
+  /**
+   * \brief Creates a renderer without a window.
+   * Everything is drawn by the software renderer.
+   *
+   * \param [in]      _width  Width of the output.
+   * \param [in]      _height Height of the output.
+   * \param [in, out] _pool   Threads to draw on.
+   * \return Returns true if the renderer was succesfully created.
+   */
+  bool CreateHeadless(int _width, int _height, ThreadPool& _pool);
+
   void Destroy(); //!< Destroy the renderer.
 
   void Clear();  //!< Clear the renderer to the clear colour.
   void Render(); //!< Draws the renderer to the window.
+  void Flush();  //!< Draw the primitives waiting in the batch.
+
+  /**
+   * \brief Get the size of the output.
+   * \param [out] _width  Width in pixels.
+   * \param [out] _height Height in pixels.
+   */
+  void GetOutputSize(int& _width, int& _height) const;
 
   /**
    * \brief Sets the colour to clear the renderer.
@@ -50,11 +75,81 @@ class Renderer
    */
   void SetRenderColour(Uint8 _r, Uint8 _g, Uint8 _b, Uint8 _a = 255);
 
+  /**
+   * \brief Set the area of the world to draw.
+   *
+   * \param [in] _offset World position at the top left of the screen.
+   * \param [in] _scale  Pixels per world unit.
+   */
+  void SetView(const Vector2& _offset, float _scale);
+
+  Vector2 ToScreen(const Vector2& _point) const; //!< Convert a world position to pixels.
+  float ToScreen(float _length) const; //!< Convert a world length to pixels.
+
+  const Vector2& GetOffset() const; //!< Get the world position at the top left of the screen.
+  float GetScale() const; //!< Get the pixels per world unit.
+
+  RenderBatch& GetBatch(); //!< Get the batch primitives are collected in.
+
+  /**
+   * \brief Build the atlas circles are drawn from as sprites.
+   * \param [in] _filename Path of the particle image.
+   * \return Returns true if the atlas was successfully created.
+   */
+  bool LoadSprites(const std::string& _filename);
+
+  /**
+   * \brief Draw circles as sprites instead of outlines.
+   * On by default only when the sprites are drawn in one call, older SDL
+   * copies each sprite on its own, which is slower than the batched outlines.
+   * \param [in] _enabled Should circles be drawn as sprites?
+   */
+  void SetSprites(bool _enabled);
+  bool GetSpritesEnabled() const; //!< Are circles drawn as sprites?
+
+  /**
+   * \brief Get the batch circle sprites are collected in.
+   * \return Returns nullptr if circles should be drawn as outlines.
+   */
+  SpriteBatch* GetSprites();
+
+  /**
+   * \brief Draw primitives on the CPU instead of through SDL.
+   * \param [in, out] _pool Threads to draw on, nullptr to use SDL.
+   */
+  void SetSoftware(ThreadPool* _pool);
+
+  /**
+   * \brief Get the software renderer primitives are collected in.
+   * \return Returns nullptr if primitives are drawn through SDL.
+   */
+  SoftwareRenderer* GetSoftware();
+
+  /**
+   * \brief Save what the software renderer has drawn.
+   * \param [in] _filename Path of the bitmap.
+   * \return Returns true if the file was written.
+   */
+  bool SaveFrame(const std::string& _filename) const;
+
   SDL_Renderer* Get() const; //!< Get the SDL renderer.
 
  private:
   SDL_Renderer* m_renderer; //!< Renderer.
   SDL_Color m_clearColour;  //!< Colour to clear the screen to.
+
+  Vector2 m_offset; //!< World position at the top left of the screen.
+  float m_scale; //!< Pixels per world unit.
+
+  RenderBatch m_batch; //!< Primitives waiting to be drawn in the current colour.
+  SpriteBatch m_sprites; //!< Circle sprites waiting to be drawn in the current colour.
+  bool m_spritesEnabled; //!< Should circles be drawn as sprites.
+
+  void FlushSoftware(); //!< Rasterize the software primitives and copy them to the output.
+
+  SoftwareRenderer m_software; //!< Draws primitives on the CPU.
+  ThreadPool* m_pool; //!< Threads for the software renderer, nullptr if it is not used.
+  Texture m_frame; //!< Streaming texture the software renderer is uploaded to.
 };
 
 #endif //_RENDERER_H_
\ No newline at end of file
@@ -1,47 +1,48 @@
 #include "SDL_Functions.h"
 
-#include <vector>
-
 namespace SDL
 {
   void DrawCircle(Renderer& _renderer, int _x, int _y, int _radius)
   {
-    int x = _radius - 1, y = 0;
-    int dx = 1, dy = 1;
-    int err = dx - (_radius << 1);
-
-    std::vector<SDL_Point> points;
-
-    while (x >= y)
+    SoftwareRenderer* software = _renderer.GetSoftware();
+    if (software != nullptr)
     {
-      points.push_back({ _x + x, _y + y });
-      points.push_back({ _x + y, _y + x });
-      points.push_back({ _x - y, _y + x });
-      points.push_back({ _x - x, _y + y });
-      points.push_back({ _x - x, _y - y });
-      points.push_back({ _x - y, _y - x });
-      points.push_back({ _x + y, _y - x });
-      points.push_back({ _x + x, _y - y });
-
-      if (err <= 0)
-      {
-        ++y;
-        err += dy;
-        dy += 2;
-      }
-      if (err > 0)
-      {
-        --x;
-        dx += 2;
-        err += dx - (_radius << 1);
-      }
+      software->AddCircle(_x, _y, _radius);
+      return;
     }
+    _renderer.GetBatch().AddCircle(_x, _y, _radius);
+  }
 
-    SDL_RenderDrawPoints(_renderer.Get(), &points[0], points.size());
+  void DrawLine(Renderer& _renderer, int _x1, int _y1, int _x2, int _y2)
+  {
+    SoftwareRenderer* software = _renderer.GetSoftware();
+    if (software != nullptr)
+    {
+      software->AddLine(_x1, _y1, _x2, _y2);
+      return;
+    }
+    _renderer.GetBatch().AddLine(_x1, _y1, _x2, _y2);
   }
 
   void DrawPoint(Renderer& _renderer, int _x, int _y)
   {
-    SDL_RenderDrawPoint(_renderer.Get(), _x, _y);
+    SoftwareRenderer* software = _renderer.GetSoftware();
+    if (software != nullptr)
+    {
+      software->AddPoint(_x, _y);
+      return;
+    }
+    _renderer.GetBatch().AddPoint(_x, _y);
+  }
+
+  void DrawRect(Renderer& _renderer, const SDL_Rect& _rect)
+  {
+    SoftwareRenderer* software = _renderer.GetSoftware();
+    if (software != nullptr)
+    {
+      software->AddRect(_rect);
+      return;
+    }
+    _renderer.GetBatch().AddRect(_rect);
   }
 }
\ No newline at end of file
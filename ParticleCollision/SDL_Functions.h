@@ -7,6 +7,8 @@ namespace SDL
 {
   /**
    * \brief Draw a circle outline.
+   * The circle is added to the renderer's batch, or its
+   * software renderer when that is in use.
    * \param [in, out] _renderer Renderer to draw to.
    * \param [in]      _x        Centre x position.
    * \param [in]      _y        Centre y position.
@@ -14,6 +16,18 @@ namespace SDL
    */
   void DrawCircle(Renderer& _renderer, int _x, int _y, int _radius);
 
+  /**
+   * \brief Draw a line.
+   * The line is added to the renderer's batch, or its
+   * software renderer when that is in use.
+   * \param [in, out] _renderer Renderer to draw to.
+   * \param [in]      _x1       Start x position.
+   * \param [in]      _y1       Start y position.
+   * \param [in]      _x2       End x position.
+   * \param [in]      _y2       End y position.
+   */
+  void DrawLine(Renderer& _renderer, int _x1, int _y1, int _x2, int _y2);
+
   /**
    * \brief Set a single pixel of a renderer.
    * \param [in, out] _renderer Renderer to draw to.
@@ -21,6 +35,15 @@ namespace SDL
    * \param [in]      _y
    */
   void DrawPoint(Renderer& _renderer, int _x, int _y);
+
+  /**
+   * \brief Draw a rectangle outline.
+   * The rectangle is added to the renderer's batch, or its
+   * software renderer when that is in use.
+   * \param [in, out] _renderer Renderer to draw to.
+   * \param [in]      _rect     Area to outline.
+   */
+  void DrawRect(Renderer& _renderer, const SDL_Rect& _rect);
 }
 
 #endif //_SDLFUNCTIONS_H_
\ No newline at end of file
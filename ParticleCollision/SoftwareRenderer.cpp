@@ -0,0 +1,299 @@
+#include "SoftwareRenderer.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "ThreadPool.h"
+
+const int SoftwareRenderer::TileSize;
+
+SoftwareRenderer::SoftwareRenderer() :
+  m_width(0), m_height(0),
+  m_tilesX(0), m_tilesY(0),
+  m_colour(0xFF000000), m_clearColour(0u),
+  m_clear(false)
+{ }
+
+SoftwareRenderer::~SoftwareRenderer()
+{ }
+
+void SoftwareRenderer::Resize(int _width, int _height)
+{
+  if (_width == m_width && _height == m_height) { return; }
+
+  m_width = std::max(_width, 0);
+  m_height = std::max(_height, 0);
+  m_pixels.assign(static_cast<size_t>(m_width) * m_height, 0u);
+
+  m_tilesX = (m_width + TileSize - 1) / TileSize;
+  m_tilesY = (m_height + TileSize - 1) / TileSize;
+  m_bins.resize(static_cast<size_t>(m_tilesX) * m_tilesY);
+
+  //anything waiting was positioned for the old size.
+  m_primitives.clear();
+}
+
+void SoftwareRenderer::SetColour(Uint8 _r, Uint8 _g, Uint8 _b, Uint8 _a)
+{
+  m_colour = (static_cast<Uint32>(_a) << 24) | (_r << 16) | (_g << 8) | _b;
+}
+
+void SoftwareRenderer::Clear(Uint32 _colour)
+{
+  m_clearColour = _colour;
+  m_clear = true;
+}
+
+void SoftwareRenderer::AddPoint(int _x, int _y)
+{
+  AddLine(_x, _y, _x, _y);
+}
+
+void SoftwareRenderer::AddLine(int _x1, int _y1, int _x2, int _y2)
+{
+  //only keep the part of the line that is on screen.
+  SDL_Rect screen = { 0, 0, m_width, m_height };
+  if (SDL_IntersectRectAndLine(&screen, &_x1, &_y1, &_x2, &_y2) == SDL_FALSE)
+  {
+    return;
+  }
+
+  Primitive line;
+  line.type = PrimitiveType::LINE;
+  line.x1 = _x1, line.y1 = _y1;
+  line.x2 = _x2, line.y2 = _y2;
+  line.colour = m_colour;
+  line.bounds.x = std::min(_x1, _x2);
+  line.bounds.y = std::min(_y1, _y2);
+  line.bounds.w = std::abs(_x2 - _x1) + 1;
+  line.bounds.h = std::abs(_y2 - _y1) + 1;
+  Add(line);
+}
+
+void SoftwareRenderer::AddCircle(int _x, int _y, int _radius)
+{
+  Primitive circle;
+  circle.type = PrimitiveType::CIRCLE;
+  circle.x1 = _x, circle.y1 = _y;
+  circle.x2 = std::max(_radius, 0), circle.y2 = 0;
+  circle.colour = m_colour;
+  circle.bounds.x = _x - circle.x2;
+  circle.bounds.y = _y - circle.x2;
+  circle.bounds.w = circle.bounds.h = circle.x2 * 2 + 1;
+  Add(circle);
+}
+
+void SoftwareRenderer::AddRect(const SDL_Rect& _rect)
+{
+  int right = _rect.x + _rect.w - 1, bottom = _rect.y + _rect.h - 1;
+  AddLine(_rect.x, _rect.y, right, _rect.y);
+  AddLine(right, _rect.y, right, bottom);
+  AddLine(right, bottom, _rect.x, bottom);
+  AddLine(_rect.x, bottom, _rect.x, _rect.y);
+}
+
+void SoftwareRenderer::Add(const Primitive& _primitive)
+{
+  //skip shapes that are completely off screen.
+  const SDL_Rect& b = _primitive.bounds;
+  if (b.x + b.w <= 0 || b.x >= m_width ||
+      b.y + b.h <= 0 || b.y >= m_height)
+  {
+    return;
+  }
+
+  m_primitives.push_back(_primitive);
+}
+
+void SoftwareRenderer::Rasterize(ThreadPool& _pool)
+{
+  if (m_pixels.empty() || (m_primitives.empty() && !m_clear))
+  {
+    m_primitives.clear();
+    return;
+  }
+
+  //sort the primitives into the tiles they touch,
+  //keeping the order they were added in.
+  for (auto& bin : m_bins)
+  {
+    bin.clear();
+  }
+
+  for (size_t i = 0; i < m_primitives.size(); ++i)
+  {
+    const SDL_Rect& b = m_primitives[i].bounds;
+    int minX = std::max(b.x, 0) / TileSize;
+    int minY = std::max(b.y, 0) / TileSize;
+    int maxX = std::min((b.x + b.w - 1) / TileSize, m_tilesX - 1);
+    int maxY = std::min((b.y + b.h - 1) / TileSize, m_tilesY - 1);
+
+    for (int y = minY; y <= maxY; ++y)
+    {
+      for (int x = minX; x <= maxX; ++x)
+      {
+        m_bins[y * m_tilesX + x].push_back(static_cast<unsigned int>(i));
+      }
+    }
+  }
+
+  //tiles do not share pixels, so each can be drawn on any thread.
+  _pool.ParallelFor(m_bins.size(), [this](size_t _tile) { DrawTile(static_cast<int>(_tile)); });
+
+  m_primitives.clear();
+  m_clear = false;
+}
+
+bool SoftwareRenderer::Empty() const
+{
+  return m_primitives.empty();
+}
+
+bool SoftwareRenderer::SaveBMP(const std::string& _filename) const
+{
+  if (m_pixels.empty()) { return false; }
+
+  //wrap the pixels, the surface does not copy them.
+  SDL_Surface* surface = SDL_CreateRGBSurfaceFrom(
+    const_cast<Uint32*>(&m_pixels[0]), m_width, m_height, 32, GetPitch(),
+    0x00FF0000, 0x0000FF00, 0x000000FF, 0xFF000000
+  );
+
+  if (surface == nullptr)
+  {
+    printf("Unable to create surface from framebuffer. SDL Error: %s\n", SDL_GetError());
+    return false;
+  }
+
+  bool success = SDL_SaveBMP(surface, _filename.c_str()) == 0;
+  if (!success)
+  {
+    printf("Unable to save %s. SDL Error: %s\n", _filename.c_str(), SDL_GetError());
+  }
+
+  SDL_FreeSurface(surface);
+  return success;
+}
+
+const Uint32* SoftwareRenderer::GetPixels() const
+{
+  return m_pixels.empty() ? nullptr : &m_pixels[0];
+}
+
+int SoftwareRenderer::GetPitch() const
+{
+  return m_width * static_cast<int>(sizeof(Uint32));
+}
+
+int SoftwareRenderer::GetWidth() const
+{
+  return m_width;
+}
+
+int SoftwareRenderer::GetHeight() const
+{
+  return m_height;
+}
+
+void SoftwareRenderer::DrawTile(int _tile)
+{
+  const std::vector<unsigned int>& bin = m_bins[_tile];
+  if (bin.empty() && !m_clear) { return; }
+
+  SDL_Rect tile;
+  tile.x = _tile % m_tilesX * TileSize;
+  tile.y = _tile / m_tilesX * TileSize;
+  tile.w = std::min(TileSize, m_width - tile.x);
+  tile.h = std::min(TileSize, m_height - tile.y);
+
+  if (m_clear)
+  {
+    for (int y = tile.y; y < tile.y + tile.h; ++y)
+    {
+      Uint32* row = &m_pixels[y * m_width + tile.x];
+      std::fill(row, row + tile.w, m_clearColour);
+    }
+  }
+
+  for (unsigned int i : bin)
+  {
+    const Primitive& primitive = m_primitives[i];
+    switch (primitive.type)
+    {
+      case PrimitiveType::LINE:   { DrawLine(primitive, tile);   break; }
+      case PrimitiveType::CIRCLE: { DrawCircle(primitive, tile); break; }
+    }
+  }
+}
+
+void SoftwareRenderer::DrawLine(const Primitive& _line, const SDL_Rect& _tile)
+{
+  int x = _line.x1, y = _line.y1;
+
+  //Bresenham's line algorithm, the same pixels as the batch.
+  int dx = std::abs(_line.x2 - x), sx = x < _line.x2 ? 1 : -1;
+  int dy = -std::abs(_line.y2 - y), sy = y < _line.y2 ? 1 : -1;
+  int err = dx + dy;
+
+  while (true)
+  {
+    Plot(x, y, _line.colour, _tile);
+
+    if (x == _line.x2 && y == _line.y2) { break; }
+
+    int err2 = err * 2;
+    if (err2 >= dy)
+    {
+      err += dy;
+      x += sx;
+    }
+    if (err2 <= dx)
+    {
+      err += dx;
+      y += sy;
+    }
+  }
+}
+
+void SoftwareRenderer::DrawCircle(const Primitive& _circle, const SDL_Rect& _tile)
+{
+  int cx = _circle.x1, cy = _circle.y1, radius = _circle.x2;
+  Uint32 colour = _circle.colour;
+
+  //a circle too small for the outline is a single pixel.
+  if (radius <= 1)
+  {
+    Plot(cx, cy, colour, _tile);
+    return;
+  }
+
+  //midpoint circle algorithm, the same pixels as the batch.
+  int x = radius - 1, y = 0;
+  int dx = 1, dy = 1;
+  int err = dx - (radius << 1);
+
+  while (x >= y)
+  {
+    Plot(cx + x, cy + y, colour, _tile);
+    Plot(cx + y, cy + x, colour, _tile);
+    Plot(cx - y, cy + x, colour, _tile);
+    Plot(cx - x, cy + y, colour, _tile);
+    Plot(cx - x, cy - y, colour, _tile);
+    Plot(cx - y, cy - x, colour, _tile);
+    Plot(cx + y, cy - x, colour, _tile);
+    Plot(cx + x, cy - y, colour, _tile);
+
+    if (err <= 0)
+    {
+      ++y;
+      err += dy;
+      dy += 2;
+    }
+    if (err > 0)
+    {
+      --x;
+      dx += 2;
+      err += dx - (radius << 1);
+    }
+  }
+}
@@ -0,0 +1,163 @@
+#ifndef _SOFTWARERENDERER_H_
+#define _SOFTWARERENDERER_H_
+
+#include <vector>
+#include <string>
+
+#include "SDL.h"
+
+class ThreadPool;
+
+/**
+ * \brief Draw primitives into a framebuffer in memory.
+ * Primitives are collected, then sorted into tiles that are
+ * rasterized on separate threads. The pixels are ARGB8888 so
+ * they can be uploaded to a streaming texture or saved without
+ * a window.
+ */
+
+class SoftwareRenderer
+{
+ public:
+  static const int TileSize = 64; //!< Width and height of a tile in pixels.
+
+  SoftwareRenderer(); //!< Constructor.
+  ~SoftwareRenderer(); //!< Destructor.
+
+  /**
+   * \brief Set the size of the framebuffer.
+   * The pixels are kept if the size has not changed.
+   * \param [in] _width  Width in pixels.
+   * \param [in] _height Height in pixels.
+   */
+  void Resize(int _width, int _height);
+
+  /**
+   * \brief Set the colour of the next primitives.
+   * \param [in] _r The red component.
+   * \param [in] _g The green component.
+   * \param [in] _b The blue component.
+   * \param [in] _a The alpha component.
+   */
+  void SetColour(Uint8 _r, Uint8 _g, Uint8 _b, Uint8 _a = 255);
+
+  /**
+   * \brief Fill the framebuffer before the next primitives are drawn.
+   * \param [in] _colour ARGB colour to fill with.
+   */
+  void Clear(Uint32 _colour);
+
+  void AddPoint(int _x, int _y); //!< Add a single pixel.
+
+  /**
+   * \brief Add a line.
+   * \param [in] _x1 Start x position.
+   * \param [in] _y1 Start y position.
+   * \param [in] _x2 End x position.
+   * \param [in] _y2 End y position.
+   */
+  void AddLine(int _x1, int _y1, int _x2, int _y2);
+
+  /**
+   * \brief Add a circle outline.
+   * \param [in] _x      Centre x position.
+   * \param [in] _y      Centre y position.
+   * \param [in] _radius Size.
+   */
+  void AddCircle(int _x, int _y, int _radius);
+
+  void AddRect(const SDL_Rect& _rect); //!< Add a rectangle outline.
+
+  /**
+   * \brief Draw the collected primitives into the framebuffer.
+   * \param [in, out] _pool Threads to draw the tiles on.
+   */
+  void Rasterize(ThreadPool& _pool);
+
+  bool Empty() const; //!< Is there anything to draw?
+
+  /**
+   * \brief Write the framebuffer to a bitmap.
+   * \param [in] _filename Path of the file.
+   * \return Returns true if the file was written.
+   */
+  bool SaveBMP(const std::string& _filename) const;
+
+  const Uint32* GetPixels() const; //!< Get the framebuffer.
+  int GetPitch() const; //!< Get the size of a row in bytes.
+
+  int GetWidth() const;  //!< Get the width of the framebuffer.
+  int GetHeight() const; //!< Get the height of the framebuffer.
+
+ private:
+  /**
+   * \brief Types of primitives.
+   */
+  enum class PrimitiveType
+  {
+    LINE,
+    CIRCLE
+  };
+
+  /**
+   * \brief Shape waiting to be drawn.
+   */
+  struct Primitive
+  {
+    PrimitiveType type; //!< Shape to draw.
+    int x1, y1; //!< Start of a line or centre of a circle.
+    int x2, y2; //!< End of a line, x2 is the radius of a circle.
+    Uint32 colour; //!< ARGB colour.
+    SDL_Rect bounds; //!< Pixels the shape can touch.
+  };
+
+  void Add(const Primitive& _primitive); //!< Store a primitive if it is on screen.
+
+  void DrawTile(int _tile); //!< Rasterize everything in a tile.
+
+  /**
+   * \brief Draw the part of a line inside a tile.
+   * \param [in] _line Line to draw.
+   * \param [in] _tile Area to draw in.
+   */
+  void DrawLine(const Primitive& _line, const SDL_Rect& _tile);
+
+  /**
+   * \brief Draw the part of a circle outline inside a tile.
+   * \param [in] _circle Circle to draw.
+   * \param [in] _tile   Area to draw in.
+   */
+  void DrawCircle(const Primitive& _circle, const SDL_Rect& _tile);
+
+  /**
+   * \brief Set a pixel if it is inside a tile.
+   * \param [in] _x      X position.
+   * \param [in] _y      Y position.
+   * \param [in] _colour ARGB colour.
+   * \param [in] _tile   Area to draw in.
+   */
+  void Plot(int _x, int _y, Uint32 _colour, const SDL_Rect& _tile)
+  {
+    if (_x >= _tile.x && _x < _tile.x + _tile.w &&
+        _y >= _tile.y && _y < _tile.y + _tile.h)
+    {
+      m_pixels[_y * m_width + _x] = _colour;
+    }
+  }
+
+  std::vector<Uint32> m_pixels; //!< Framebuffer.
+  int m_width;  //!< Width of the framebuffer.
+  int m_height; //!< Height of the framebuffer.
+
+  int m_tilesX; //!< Number of tile columns.
+  int m_tilesY; //!< Number of tile rows.
+
+  std::vector<Primitive> m_primitives; //!< Shapes to draw.
+  std::vector<std::vector<unsigned int>> m_bins; //!< Primitives touching each tile, in order.
+
+  Uint32 m_colour; //!< Colour of the next primitives.
+  Uint32 m_clearColour; //!< Colour to fill with.
+  bool m_clear; //!< Should the tiles be filled before drawing.
+};
+
+#endif //_SOFTWARERENDERER_H_
@@ -5,6 +5,7 @@
 #include "Renderer.h"
 
 #include "HashTable.h"
+#include "DebugDraw.h"
 
 template<class Type>
 class SpatialHash : public HashTable<Type>
@@ -179,6 +180,31 @@ public:
     }
   }
 
+  /**
+   * \brief Add the outlines of the occupied cells to draw.
+   * Empty cells and cells too small on screen are skipped, the
+   * rest are drawn together in one batch.
+   *
+   * \param [in, out] _debug Culls and stores the rects.
+   */
+  void Draw(DebugDraw &_debug) const
+  {
+    //dont draw if there is no hashtable
+    if (m_hashTable == nullptr) { return; }
+
+    for (int i = 0; i < m_size; i++)
+    {
+      if (m_hashTable[i].empty()) { continue; }
+
+      //get the area of the cell
+      float x = (i % m_width) * m_cellWidth;
+      float y = (i / m_width) * m_cellHeight;
+      Rect cell(x, y, x + m_cellWidth, y + m_cellHeight);
+
+      if (_debug.ShowNode(cell, 0)) { _debug.AddRect(cell); }
+    }
+  }
+
   int Width(void)  const { return m_width;  } //!< Get the width.
   int Height(void) const { return m_height; } //!< Get the height.
 };
@@ -0,0 +1,157 @@
+#include "SpriteBatch.h"
+
+#include <algorithm>
+
+#include "Renderer.h"
+
+const int SpriteBatch::MaxRadius;
+
+SpriteBatch::SpriteBatch()
+{
+  m_colour.r = m_colour.g = m_colour.b = m_colour.a = 255;
+  SetClip(0, 0);
+}
+
+SpriteBatch::~SpriteBatch()
+{ }
+
+bool SpriteBatch::Create(Renderer& _renderer, const std::string& _filename)
+{
+  Destroy(); //destroy any existing atlas
+
+  //load the image
+  SDL_Surface* loaded = IMG_Load(_filename.c_str());
+
+  if (loaded == nullptr)
+  {
+    printf("Unabled to load image %s. SDL_image Error: %s\n", _filename.c_str(), IMG_GetError());
+    return false;
+  }
+
+  //use a known format so the atlas can copy the alpha.
+  SDL_Surface* image = SDL_ConvertSurfaceFormat(loaded, SDL_PIXELFORMAT_RGBA8888, 0);
+  SDL_FreeSurface(loaded);
+
+  if (image == nullptr)
+  {
+    printf("Unable to convert image %s. SDL Error: %s\n", _filename.c_str(), SDL_GetError());
+    return false;
+  }
+
+  //place the radius classes in rows, smallest first.
+  //leave a pixel between them so filtering does not bleed.
+  const int width = 256;
+  int x = 1, y = 1, row = 0;
+
+  m_regions.resize(MaxRadius);
+  for (int r = 1; r <= MaxRadius; ++r)
+  {
+    int size = r * 2;
+    if (x + size + 1 > width)
+    {
+      x = 1;
+      y += row + 1;
+      row = 0;
+    }
+    m_regions[r - 1] = { x, y, size, size };
+    x += size + 1;
+    row = std::max(row, size);
+  }
+  int height = y + row + 1;
+
+  SDL_Surface* atlas = SDL_CreateRGBSurface(
+    0, width, height, 32,
+    image->format->Rmask, image->format->Gmask, image->format->Bmask, image->format->Amask
+  );
+
+  if (atlas == nullptr)
+  {
+    printf("Unable to create atlas surface. SDL Error: %s\n", SDL_GetError());
+    SDL_FreeSurface(image);
+    m_regions.clear();
+    return false;
+  }
+
+  //copy the pixels as they are instead of blending them.
+  SDL_SetSurfaceBlendMode(image, SDL_BLENDMODE_NONE);
+  for (auto& region : m_regions)
+  {
+    SDL_BlitScaled(image, nullptr, atlas, &region);
+  }
+  SDL_FreeSurface(image);
+
+  bool success = m_atlas.CreateFromSurface(_renderer, atlas);
+  SDL_FreeSurface(atlas);
+
+  if (!success)
+  {
+    m_regions.clear();
+    return false;
+  }
+
+  SDL_SetTextureBlendMode(m_atlas.Get(), SDL_BLENDMODE_BLEND);
+  return true;
+}
+
+void SpriteBatch::Destroy()
+{
+  Clear();
+  m_atlas.Destroy();
+  m_regions.clear();
+}
+
+bool SpriteBatch::IsCreated() const
+{
+  return !m_regions.empty();
+}
+
+void SpriteBatch::SetClip(int _width, int _height)
+{
+  m_clip.x = m_clip.y = 0;
+  m_clip.w = _width;
+  m_clip.h = _height;
+}
+
+void SpriteBatch::SetColour(const SDL_Color& _colour)
+{
+  m_colour = _colour;
+}
+
+void SpriteBatch::AddCircle(float _x, float _y, float _radius)
+{
+  if (!IsCreated()) { return; }
+
+  //skip circles that are completely off screen.
+  if (m_clip.w > 0 && m_clip.h > 0 &&
+      (_x + _radius < 0 || _x - _radius >= m_clip.w ||
+       _y + _radius < 0 || _y - _radius >= m_clip.h))
+  {
+    return;
+  }
+
+  float size = _radius * 2.f;
+  m_quads.AddQuad(GetRegion(_radius), _x - _radius, _y - _radius, size, size, m_colour);
+}
+
+void SpriteBatch::Flush(SDL_Renderer* _renderer)
+{
+  m_quads.Flush(_renderer, m_atlas);
+}
+
+void SpriteBatch::Clear()
+{
+  m_quads.Clear();
+}
+
+bool SpriteBatch::Empty() const
+{
+  return m_quads.Empty();
+}
+
+const SDL_Rect& SpriteBatch::GetRegion(float _radius) const
+{
+  //round to the nearest class, larger circles scale the biggest one.
+  int r = static_cast<int>(_radius + .5f);
+  r = std::min(std::max(r, 1), MaxRadius);
+  return m_regions[r - 1];
+}
@@ -0,0 +1,80 @@
+#ifndef _SPRITEBATCH_H_
+#define _SPRITEBATCH_H_
+
+#include <vector>
+#include <string>
+
+#include "SDL.h"
+
+#include "Texture.h"
+#include "QuadBatch.h"
+
+class Renderer;
+
+/**
+ * \brief Draw circles as textured quads from one atlas.
+ * The atlas holds a copy of the particle image for every radius
+ * class, so each circle is a single quad instead of an outline of
+ * points. The quads are collected in a QuadBatch.
+ */
+
+class SpriteBatch
+{
+ public:
+  static const int MaxRadius = 32; //!< Largest radius class in the atlas.
+
+  SpriteBatch(); //!< Constructor.
+  ~SpriteBatch(); //!< Destructor.
+
+  /**
+   * \brief Build the atlas from an image.
+   * \param [in] _renderer Renderer the atlas is used with.
+   * \param [in] _filename Path of the particle image.
+   * \return Returns true if the atlas was successfully created.
+   */
+  bool Create(Renderer& _renderer, const std::string& _filename);
+
+  void Destroy(); //!< Free the atlas.
+
+  bool IsCreated() const; //!< Has the atlas been built?
+
+  /**
+   * \brief Set the area sprites are clipped to.
+   * \param [in] _width  Width of the output in pixels.
+   * \param [in] _height Height of the output in pixels.
+   */
+  void SetClip(int _width, int _height);
+
+  void SetColour(const SDL_Color& _colour); //!< Set the tint of the next sprites.
+
+  /**
+   * \brief Add a circle.
+   * \param [in] _x      Centre x position in pixels.
+   * \param [in] _y      Centre y position in pixels.
+   * \param [in] _radius Size in pixels.
+   */
+  void AddCircle(float _x, float _y, float _radius);
+
+  /**
+   * \brief Draw everything in the batch and empty it.
+   * \param [in, out] _renderer Renderer to draw to.
+   */
+  void Flush(SDL_Renderer* _renderer);
+
+  void Clear(); //!< Empty the batch, keeping the storage.
+
+  bool Empty() const; //!< Is there anything to draw?
+
+ private:
+  const SDL_Rect& GetRegion(float _radius) const; //!< Get the atlas area of the closest radius class.
+
+  Texture m_atlas; //!< Particle image at every radius class.
+  std::vector<SDL_Rect> m_regions; //!< Area of each radius class in the atlas.
+
+  SDL_Color m_colour; //!< Tint of the sprites.
+  SDL_Rect m_clip; //!< Area of the output.
+
+  QuadBatch m_quads; //!< Quads to draw.
+};
+
+#endif //_SPRITEBATCH_H_
@@ -70,6 +70,25 @@ bool Texture::Load(Renderer& _renderer, const std::string& _filename)
   return m_texture != nullptr;
 }
 
+bool Texture::CreateFromSurface(Renderer& _renderer, SDL_Surface* _surface)
+{
+  Destroy(); //destroy any existing texture
+
+  //create texture
+  m_texture = SDL_CreateTextureFromSurface(_renderer.Get(), _surface);
+
+  if (m_texture == nullptr)
+  {
+    printf("Unable to create texture from surface. SDL Error: %s\n", SDL_GetError());
+    return false;
+  }
+
+  m_width = _surface->w;
+  m_height = _surface->h;
+
+  return true;
+}
+
 bool Texture::CreateFromText(Renderer& _renderer, const Font& _font, const std::string& _text, const SDL_Color& _colour)
 {
   Destroy(); //destroy any existing texture
@@ -102,8 +121,15 @@ bool Texture::CreateFromText(Renderer& _renderer, const Font& _font, const std::
   return m_texture != nullptr;
 }
 
+bool Texture::Update(const void* _pixels, int _pitch)
+{
+  return m_texture != nullptr && SDL_UpdateTexture(m_texture, nullptr, _pixels, _pitch) == 0;
+}
+
 void Texture::Draw(Renderer &_renderer, SDL_Rect *_src, SDL_Rect *_dst, float _angle, SDL_Point *_centre, SDL_RendererFlip _flip)
 {
+  //keep the batched primitives underneath the texture.
+  _renderer.Flush();
   SDL_RenderCopyEx(_renderer.Get(), m_texture, _src, _dst, _angle, _centre, _flip);
 }
 
@@ -122,4 +148,9 @@ int Texture::GetWidth() const
 int Texture::GetHeight() const
 {
   return m_height;
+}
+
+SDL_Texture* Texture::Get() const
+{
+  return m_texture;
 }
\ No newline at end of file
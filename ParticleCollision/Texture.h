@@ -37,6 +37,14 @@ class Texture
    * \return Returns true if texture was successfully created.
    */
   bool Load(Renderer& _renderer, const std::string& _filename);
+
+  /**
+   * \brief Create a texture from a surface.
+   * \param [in] _renderer Constrains for the texture.
+   * \param [in] _surface  Pixels to copy, still owned by the caller.
+   * \return Returns true if texture was successfully created.
+   */
+  bool CreateFromSurface(Renderer& _renderer, SDL_Surface* _surface);
   
   /**
    * \brief Create a texture from text.
@@ -53,6 +61,14 @@ class Texture
     const SDL_Color& _colour
   );
 
+  /**
+   * \brief Replace the pixels of a streaming texture.
+   * \param [in] _pixels Pixels in the format of the texture.
+   * \param [in] _pitch  Size of a row in bytes.
+   * \return Returns true if the texture was updated.
+   */
+  bool Update(const void* _pixels, int _pitch);
+
   /**
    * \brief Draw the texture to a renderer.
    * \param [in] _renderer The renderer to draw to.
@@ -82,6 +98,8 @@ class Texture
   int GetWidth() const;  //!< Get the width of the texture.
   int GetHeight() const; //!< Get the height of the texture.
 
+  SDL_Texture* Get() const; //!< Get the SDL texture.
+
  private:
   SDL_Texture* m_texture; //!< Texture.
 
@@ -0,0 +1,107 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t _threads) :
+  m_task(nullptr),
+  m_count(0u), m_next(0u), m_active(0u),
+  m_generation(0u),
+  m_quit(false)
+{
+  if (_threads == 0u)
+  {
+    //the calling thread works as well.
+    unsigned int cores = std::thread::hardware_concurrency();
+    _threads = cores > 1u ? cores - 1u : 0u;
+  }
+
+  for (size_t i = 0; i < _threads; ++i)
+  {
+    m_threads.emplace_back(&ThreadPool::Work, this);
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_quit = true;
+  }
+  m_start.notify_all();
+
+  for (auto& thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+size_t ThreadPool::GetThreadCount() const
+{
+  return m_threads.size() + 1u;
+}
+
+void ThreadPool::ParallelFor(size_t _count, const std::function<void(size_t)>& _task)
+{
+  if (_count == 0u) { return; }
+
+  //not worth waking the workers.
+  if (m_threads.empty() || _count == 1u)
+  {
+    for (size_t i = 0; i < _count; ++i)
+    {
+      _task(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = &_task;
+    m_count = _count;
+    m_next = 0u;
+    m_active = m_threads.size();
+    ++m_generation;
+  }
+  m_start.notify_all();
+
+  RunTasks(_task);
+
+  //wait for the workers to finish their last task.
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this] { return m_active == 0u; });
+  m_task = nullptr;
+}
+
+void ThreadPool::Work()
+{
+  unsigned int generation = 0u;
+
+  while (true)
+  {
+    const std::function<void(size_t)>* task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_start.wait(lock, [&] { return m_quit || m_generation != generation; });
+
+      if (m_quit) { return; }
+
+      generation = m_generation;
+      task = m_task;
+    }
+
+    RunTasks(*task);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_active == 0u)
+    {
+      m_done.notify_one();
+    }
+  }
+}
+
+void ThreadPool::RunTasks(const std::function<void(size_t)>& _task)
+{
+  size_t i;
+  while ((i = m_next++) < m_count)
+  {
+    _task(i);
+  }
+}
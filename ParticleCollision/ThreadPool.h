@@ -0,0 +1,55 @@
+#ifndef _THREADPOOL_H_
+#define _THREADPOOL_H_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+/**
+ * \brief Fixed set of worker threads.
+ * Work is given as a number of tasks, the workers and the calling
+ * thread take tasks until they are all done.
+ */
+
+class ThreadPool
+{
+ public:
+  /**
+   * \brief Constructor.
+   * \param [in] _threads Number of workers. 0 uses one less
+   *                      than the number of cores.
+   */
+  ThreadPool(size_t _threads = 0);
+  ~ThreadPool(); //!< Destructor.
+
+  size_t GetThreadCount() const; //!< Get the number of threads, including the caller.
+
+  /**
+   * \brief Run tasks on all the threads and wait for them.
+   * \param [in] _count Number of tasks.
+   * \param [in] _task  Called once with the index of every task.
+   */
+  void ParallelFor(size_t _count, const std::function<void(size_t)>& _task);
+
+ private:
+  void Work(); //!< Loop of the workers.
+  void RunTasks(const std::function<void(size_t)>& _task); //!< Take tasks until there are none left.
+
+  std::vector<std::thread> m_threads; //!< Workers.
+
+  std::mutex m_mutex; //!< Guards the state below.
+  std::condition_variable m_start; //!< Wakes the workers for new work.
+  std::condition_variable m_done; //!< Wakes the caller when the workers finish.
+
+  const std::function<void(size_t)>* m_task; //!< Current work.
+  size_t m_count; //!< Number of tasks of the current work.
+  std::atomic<size_t> m_next; //!< Next task to take.
+  size_t m_active; //!< Workers still running the current work.
+  unsigned int m_generation; //!< Changes each time work is given.
+  bool m_quit; //!< Should the workers stop.
+};
+
+#endif //_THREADPOOL_H_
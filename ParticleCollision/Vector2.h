@@ -1,42 +1,82 @@
 #ifndef _VECTOR2_H_
 #define _VECTOR2_H_
 
+#include <cmath>
+
+/**
+ * \brief Define a 2D vector.
+ * Everything is inline so the small functions used in the
+ * collision loops do not need a call into another file.
+ */
+
 class Vector2
 {
 public:
   float x, y;
 
-  Vector2();
-  Vector2(float _val);
-  Vector2(float _x, float _y);
-  Vector2(const Vector2& _other);
+  constexpr Vector2() : x(.0f), y(.0f) { }
+  constexpr Vector2(float _val) : x(_val), y(_val) { }
+  constexpr Vector2(float _x, float _y) : x(_x), y(_y) { }
+
+  float Magnitude() const { return std::sqrt(x * x + y * y); }
+  constexpr float MagnitudeSq() const { return x * x + y * y; }
 
-  float Magnitude() const;
-  float MagnitudeSq() const;
+  /**
+   * \brief Get the vector with a length of 1.
+   * \return Returns the unit vector, or a zero vector if the length is 0.
+   */
+  Vector2 Normalized() const
+  {
+    float m = Magnitude();
+    if (m == .0f) { return Vector2(); }
 
-  Vector2 Normalized() const;
+    float inv = 1.f / m;
+    return Vector2(x * inv, y * inv);
+  }
 
-  Vector2 Left() const;
-  Vector2 Right() const;
+  constexpr Vector2 Left() const { return Vector2(y, -x); }
+  constexpr Vector2 Right() const { return Vector2(-y, x); }
 
-  Vector2 operator=(const Vector2 &_rhs);
+  Vector2& operator+=(const Vector2 &_rhs) { x += _rhs.x; y += _rhs.y; return *this; }
+  Vector2& operator-=(const Vector2 &_rhs) { x -= _rhs.x; y -= _rhs.y; return *this; }
 
-  Vector2 operator+=(const Vector2 &_rhs);
-  Vector2 operator-=(const Vector2 &_rhs);
+  Vector2& operator*=(float _scalar) { x *= _scalar; y *= _scalar; return *this; }
+  Vector2& operator/=(float _scalar) { x /= _scalar; y /= _scalar; return *this; }
 
-  Vector2 operator*=(const float &_scalar);
-  Vector2 operator/=(const float &_scalar);
+  static constexpr float Dot(const Vector2 &_lhs, const Vector2 &_rhs)
+  {
+    return _lhs.x * _rhs.x + _lhs.y * _rhs.y;
+  }
 
-  static float Dot(const Vector2 &_lhs, const Vector2 &_rhs);
+  static Vector2 AngleToVector(float _radians)
+  {
+    return Vector2(std::cos(_radians), std::sin(_radians));
+  }
 
-  static Vector2 AngleToVector(float _radians);
-  static float VectorToAngle(const Vector2 &_vector);
+  static float VectorToAngle(const Vector2 &_vector)
+  {
+    return std::atan2(_vector.y, _vector.x);
+  }
 };
 
-Vector2 operator+(const Vector2 &_lhs, const Vector2 &_rhs);
-Vector2 operator-(const Vector2 &_lhs, const Vector2 &_rhs);
+constexpr Vector2 operator+(const Vector2 &_lhs, const Vector2 &_rhs)
+{
+  return Vector2(_lhs.x + _rhs.x, _lhs.y + _rhs.y);
+}
 
-Vector2 operator*(const Vector2 &_lhs, const float &_rhs);
-Vector2 operator/(const Vector2 &_lhs, const float &_rhs);
+constexpr Vector2 operator-(const Vector2 &_lhs, const Vector2 &_rhs)
+{
+  return Vector2(_lhs.x - _rhs.x, _lhs.y - _rhs.y);
+}
+
+constexpr Vector2 operator*(const Vector2 &_lhs, float _rhs)
+{
+  return Vector2(_lhs.x * _rhs, _lhs.y * _rhs);
+}
+
+constexpr Vector2 operator/(const Vector2 &_lhs, float _rhs)
+{
+  return Vector2(_lhs.x / _rhs, _lhs.y / _rhs);
+}
 
-#endif //_VECTOR2_H_
\ No newline at end of file
+#endif //_VECTOR2_H_
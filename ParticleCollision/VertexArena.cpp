@@ -0,0 +1,87 @@
+#include "VertexArena.h"
+
+#include "Kernels.h"
+
+const size_t VertexArena::Width;
+
+VertexArena::VertexArena()
+{ }
+
+VertexArena& VertexArena::Get()
+{
+  static VertexArena arena;
+  return arena;
+}
+
+size_t VertexArena::Padded(size_t _count)
+{
+  return (_count + Width - 1u) / Width * Width;
+}
+
+size_t VertexArena::Allocate(size_t _count)
+{
+  //every block has at least one group.
+  size_t size = Padded(_count > 0u ? _count : 1u);
+  size_t groups = size / Width;
+
+  //reuse a block of the same size.
+  if (groups < m_free.size() && !m_free[groups].empty())
+  {
+    size_t offset = m_free[groups].back();
+    m_free[groups].pop_back();
+    return offset;
+  }
+
+  //the arrays always hold whole groups, so the new block is aligned.
+  size_t offset = m_x.size();
+  m_x.resize(offset + size, 0.f);
+  m_y.resize(offset + size, 0.f);
+  return offset;
+}
+
+void VertexArena::Free(size_t _offset, size_t _count)
+{
+  size_t groups = Padded(_count > 0u ? _count : 1u) / Width;
+
+  if (groups >= m_free.size())
+  {
+    m_free.resize(groups + 1u);
+  }
+  m_free[groups].push_back(_offset);
+}
+
+void VertexArena::Set(size_t _offset, const Vector2* _points, size_t _count)
+{
+  for (size_t i = 0; i < _count; ++i)
+  {
+    m_x[_offset + i] = _points[i].x;
+    m_y[_offset + i] = _points[i].y;
+  }
+
+  //repeat the first vertex so the padding never changes a projection.
+  Vector2 first = _count > 0u ? _points[0] : Vector2();
+  for (size_t i = _count; i < Padded(_count); ++i)
+  {
+    m_x[_offset + i] = first.x;
+    m_y[_offset + i] = first.y;
+  }
+}
+
+Range VertexArena::Project(size_t _offset, size_t _count, const Vector2& _axis) const
+{
+  const float* x = &m_x[_offset];
+  const float* y = &m_y[_offset];
+  size_t size = Padded(_count);
+
+  return Kernels::Get().project(x, y, size, _axis);
+}
+
+const float* VertexArena::GetX() const
+{
+  return m_x.data();
+}
+
+const float* VertexArena::GetY() const
+{
+  return m_y.data();
+}
@@ -0,0 +1,80 @@
+#ifndef _VERTEXARENA_H_
+#define _VERTEXARENA_H_
+
+#include <vector>
+
+#include "Maths.h"
+#include "Range.h"
+
+/**
+ * \brief Shared storage for polygon vertices.
+ * The x and y of every vertex are kept in two arrays. Each polygon
+ * has a block that starts on a multiple of Width and is padded to
+ * a multiple of Width with copies of its first vertex, so vertices
+ * can be projected Width at a time without checking for the end.
+ * Blocks are addressed by offset, as the arrays move when they grow.
+ */
+
+class VertexArena
+{
+ public:
+  static const size_t Width = 4; //!< Number of vertices projected at once.
+
+  static VertexArena& Get(); //!< Get the arena shared by all polygons.
+
+  /**
+   * \brief Get the size of the block for a number of vertices.
+   * \param [in] _count Number of vertices.
+   * \return Returns the count rounded up to a multiple of Width.
+   */
+  static size_t Padded(size_t _count);
+
+  /**
+   * \brief Reserve a block of vertices.
+   * \param [in] _count Number of vertices.
+   * \return Returns the offset of the block.
+   */
+  size_t Allocate(size_t _count);
+
+  /**
+   * \brief Give a block back to be reused.
+   * \param [in] _offset Offset of the block.
+   * \param [in] _count  Number of vertices it was allocated with.
+   */
+  void Free(size_t _offset, size_t _count);
+
+  /**
+   * \brief Set the vertices of a block and fill its padding.
+   * \param [in] _offset Offset of the block.
+   * \param [in] _points Vertices to store.
+   * \param [in] _count  Number of vertices.
+   */
+  void Set(size_t _offset, const Vector2* _points, size_t _count);
+
+  Vector2 GetPoint(size_t _offset, size_t _index) const
+  {
+    return Vector2(m_x[_offset + _index], m_y[_offset + _index]);
+  } //!< Get a vertex of a block.
+
+  /**
+   * \brief Get the range of a block's vertices on an axis.
+   * \param [in] _offset Offset of the block.
+   * \param [in] _count  Number of vertices.
+   * \param [in] _axis   Axis to project onto.
+   * \return Returns the minimum and maximum projection.
+   */
+  Range Project(size_t _offset, size_t _count, const Vector2& _axis) const;
+
+  const float* GetX() const; //!< Get the x of every vertex.
+  const float* GetY() const; //!< Get the y of every vertex.
+
+ private:
+  VertexArena(); //!< Constructor. Use Get.
+
+  std::vector<float> m_x; //!< X of every vertex.
+  std::vector<float> m_y; //!< Y of every vertex.
+
+  std::vector<std::vector<size_t>> m_free; //!< Free blocks, by size in groups of Width.
+};
+
+#endif //_VERTEXARENA_H_